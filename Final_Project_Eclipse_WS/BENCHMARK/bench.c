@@ -0,0 +1,216 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench.c
+ *
+ * Description: Source file for the driver benchmark harness
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "bench.h"
+#include "common_macros.h"
+#include "timer1.h"
+#include "uart.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/delay.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+typedef struct {
+	const char *name;
+	uint32 cycles;
+	uint16 stack_bytes;
+} Bench_ResultType;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* End of .bss given by the linker, the free RAM starts there */
+extern uint8 __heap_start;
+
+static volatile uint16 g_overflows = 0;
+static uint32 g_overheadCycles = 0;
+
+static Bench_ResultType g_results[BENCH_MAX_RESULTS];
+static uint8 g_resultCount = 0;
+
+/* Every call of Bench_measure, also the ones over BENCH_MAX_RESULTS which are not saved */
+static uint8 g_measureCount = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Timer1 overflow call-back, counts the high 16 bits of the cycle counter.
+ */
+static void Bench_countOverflow(void);
+
+/*
+ * Description :
+ * Return the CPU cycles counted since Bench_init.
+ */
+static uint32 Bench_getCycles(void);
+
+/*
+ * Description :
+ * Empty operation, measures the cost of the harness itself.
+ */
+static void Bench_nothing(void);
+
+/*
+ * Description :
+ * Send a string or an unsigned number on the UART.
+ */
+static void Bench_sendString(const char *Str);
+static void Bench_sendNumber(uint32 number);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+	Bench_init();
+	Bench_runDriver();
+	Bench_report();
+
+	return 0;
+}
+
+void Bench_init(void)
+{
+	UART_ConfigType UART_Configs = {BITS_8, NO_PARITY, BIT_1, BENCH_BAUD_RATE, UART_INTERRUPT_MODE};
+	Timer1_ConfigType Timer1_Configs = {0, 0, F_CPU_1, NORMAL_MODE};
+	uint32 start;
+
+	UART_init(&UART_Configs);
+	Timer1_setCallBack(Bench_countOverflow);
+	Timer1_init(&Timer1_Configs);
+	sei();
+
+	start = Bench_getCycles();
+	Bench_nothing();
+	g_overheadCycles = Bench_getCycles() - start;
+}
+
+void Bench_measure(const char *name, void (*operation_Ptr)(void))
+{
+	uint8 *stack_Ptr;
+	uint8 *top_Ptr = (uint8 *)SP - BENCH_STACK_GUARD;
+	uint32 start;
+	uint32 cycles;
+
+	g_measureCount++;
+	if (g_resultCount == BENCH_MAX_RESULTS)
+	{
+		return;
+	}
+
+	for (stack_Ptr = &__heap_start; stack_Ptr < top_Ptr; stack_Ptr++)
+	{
+		*stack_Ptr = BENCH_STACK_PAINT;
+	}
+
+	start = Bench_getCycles();
+	(*operation_Ptr)();
+	cycles = Bench_getCycles() - start;
+
+	/* The lowest byte changed is the deepest the stack went */
+	for (stack_Ptr = &__heap_start; stack_Ptr < top_Ptr && *stack_Ptr == BENCH_STACK_PAINT; stack_Ptr++){}
+
+	g_results[g_resultCount].name = name;
+	g_results[g_resultCount].cycles = (cycles > g_overheadCycles) ? (cycles - g_overheadCycles) : 0;
+	g_results[g_resultCount].stack_bytes = (uint16)(top_Ptr + BENCH_STACK_GUARD - stack_Ptr);
+	g_resultCount++;
+}
+
+uint32 Bench_getTimeUs(void)
+{
+	return Bench_getCycles() / (F_CPU / 1000000UL);
+}
+
+void Bench_report(void)
+{
+	uint8 i;
+
+	/* The UART benchmarks send bytes without a new line, the first result line should not follow them */
+	Bench_sendString("\n");
+
+	for (i = 0; i < g_resultCount; i++)
+	{
+		Bench_sendString("BENCH\t");
+		Bench_sendString(g_results[i].name);
+		Bench_sendString("\t");
+		Bench_sendNumber(g_results[i].cycles);
+		Bench_sendString("\t");
+		Bench_sendNumber(g_results[i].stack_bytes);
+		Bench_sendString("\n");
+	}
+	Bench_sendString("END\t");
+	Bench_sendNumber(g_measureCount);
+	Bench_sendString("\n");
+
+	/* Let the TX buffer go out, then sleep with the interrupts disabled, simavr stops there */
+	_delay_ms(BENCH_DRAIN_TIME_MS);
+	cli();
+	sleep_enable();
+	sleep_cpu();
+}
+
+static void Bench_countOverflow(void)
+{
+	g_overflows++;
+}
+
+static uint32 Bench_getCycles(void)
+{
+	uint8 sreg = SREG;
+	uint16 low;
+	uint16 high;
+
+	cli();
+	low = TCNT1;
+	high = g_overflows;
+
+	/* The counter restarted but its overflow interrupt is not served yet */
+	if (BIT_IS_SET(TIFR, TOV1) && low < 0X8000)
+	{
+		high++;
+	}
+	SREG = sreg;
+
+	return ((uint32)high << 16) | low;
+}
+
+static void Bench_nothing(void)
+{
+}
+
+static void Bench_sendString(const char *Str)
+{
+	UART_sendString((const uint8 *)Str);
+}
+
+static void Bench_sendNumber(uint32 number)
+{
+	char digits[11];
+
+	ultoa(number, digits, 10);
+	Bench_sendString(digits);
+}
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench.h
+ *
+ * Description: Header file for the driver benchmark harness
+ *
+ * Every driver is built alone with this harness into one ATmega16 ELF
+ * (bench_<driver>.elf) which runs under simavr. Each operation is called once
+ * and measured on the target itself:
+ * - cycles: Timer1 counts the CPU clock (no pre-scaler), the overflows are
+ *   counted in its ISR, and the cost of an empty operation is subtracted.
+ * - stack:  the free RAM under the stack is painted before the call and the
+ *   deepest byte changed is found after it, ISRs run meanwhile are included.
+ * The results are sent on the UART at the end, one line per operation:
+ *   BENCH <tab> operation <tab> cycles <tab> stack bytes
+ * then END <tab> operations measured, so a lost result line can be detected.
+ * The flash of every operation is added from the ELF symbols by the Makefile.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Operations that can be measured in one ELF */
+#define BENCH_MAX_RESULTS      16
+
+/* Value painted on the free RAM, and the bytes under the stack pointer left unpainted */
+#define BENCH_STACK_PAINT      0XA5
+#define BENCH_STACK_GUARD      8
+
+/* UART used to send the results, also the time needed to send its whole TX buffer */
+#define BENCH_BAUD_RATE        BAUD_RATE_38400
+#define BENCH_DRAIN_TIME_MS    20
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start the UART in interrupt mode and Timer1 as the cycle counter, then enable the interrupts.
+ */
+void Bench_init(void);
+
+/*
+ * Description :
+ * Call the operation once and save its cycles and stack use under the given name.
+ * The name should be the driver function measured, its flash size is found by that name.
+ */
+void Bench_measure(const char *name, void (*operation_Ptr)(void));
+
+/*
+ * Description :
+ * Return the cycle counter in micro-seconds, a time source for the drivers that need one.
+ */
+uint32 Bench_getTimeUs(void);
+
+/*
+ * Description :
+ * Send the saved results on the UART and stop the CPU, which ends the simulation.
+ * The report starts on a new line, after anything the measured operations sent on the UART.
+ */
+void Bench_report(void);
+
+/*
+ * Description :
+ * Initialize the driver and measure its operations, given by every bench_<driver>.c.
+ */
+void Bench_runDriver(void);
+
+#endif /* BENCH_H_ */
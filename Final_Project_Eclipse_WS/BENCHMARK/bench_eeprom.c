@@ -0,0 +1,76 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_eeprom.c
+ *
+ * Description: Operations of the external EEPROM driver measured by the harness
+ * The runner puts a 24C16 model on the TWI bus, which NACKs its address
+ * during the 5ms write cycle like the real device.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "bench.h"
+#include "twi.h"
+#include "external_eeprom.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BENCH_EEPROM_ADDRESS 0X0010
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static uint8 g_page[EEPROM_PAGE_SIZE];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Bench_writeByte(void)
+{
+	EEPROM_writeByte(BENCH_EEPROM_ADDRESS, 0X55);
+}
+
+static void Bench_waitReady(void)
+{
+	EEPROM_waitReady();
+}
+
+static void Bench_readByte(void)
+{
+	uint8 data;
+
+	EEPROM_readByte(BENCH_EEPROM_ADDRESS, &data);
+}
+
+static void Bench_writeBlock(void)
+{
+	EEPROM_writeBlock(BENCH_EEPROM_ADDRESS, g_page, sizeof(g_page));
+}
+
+static void Bench_readBlock(void)
+{
+	EEPROM_readBlock(BENCH_EEPROM_ADDRESS, g_page, sizeof(g_page));
+}
+
+void Bench_runDriver(void)
+{
+	TWI_ConfigType TWI_Configs = {0X01, BIT_RATE_400_KBS};
+
+	TWI_init(&TWI_Configs);
+
+	/* A write returns at the start of the write cycle, the wait after it covers the whole cycle */
+	Bench_measure("EEPROM_writeByte", Bench_writeByte);
+	Bench_measure("EEPROM_waitReady", Bench_waitReady);
+	Bench_measure("EEPROM_readByte", Bench_readByte);
+	Bench_measure("EEPROM_writeBlock", Bench_writeBlock);
+	Bench_measure("EEPROM_readBlock", Bench_readBlock);
+}
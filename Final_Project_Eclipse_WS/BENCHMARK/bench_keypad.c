@@ -0,0 +1,57 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_keypad.c
+ *
+ * Description: Operations of the Keypad driver measured by the harness
+ * The runner holds the first button (first row pin wired to the first
+ * column pin), so KEYPAD_getPressedKey returns on its first scan and every
+ * scan takes the pressed key path.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "bench.h"
+#include "keypad.h"
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Bench_getPressedKey(void)
+{
+	KEYPAD_getPressedKey();
+}
+
+static void Bench_scanKey(void)
+{
+	KEYPAD_scanKey();
+}
+
+static void Bench_getEvent(void)
+{
+	KEYPAD_KeyEventType event;
+
+	KEYPAD_getEvent(&event);
+}
+
+void Bench_runDriver(void)
+{
+	uint8 scan;
+
+	Bench_measure("KEYPAD_init", KEYPAD_init);
+	Bench_measure("KEYPAD_scanKey", Bench_scanKey);
+	Bench_measure("KEYPAD_getPressedKey", Bench_getPressedKey);
+
+	/* The last debounce scan queues the pressed event */
+	for (scan = 1; scan < KEYPAD_DEBOUNCE_SCANS; scan++)
+	{
+		KEYPAD_processScan();
+	}
+	Bench_measure("KEYPAD_processScan", KEYPAD_processScan);
+	Bench_measure("KEYPAD_getEvent", Bench_getEvent);
+}
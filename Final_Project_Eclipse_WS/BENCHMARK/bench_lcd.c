@@ -0,0 +1,79 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_lcd.c
+ *
+ * Description: Operations of the LCD driver measured by the harness
+ * Nothing answers on the LCD pins under simavr, so in LCD_BUSY_FLAG_MODE 1
+ * the busy flag reads ready at once and only the cost of polling it is measured.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "bench.h"
+#include "lcd.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Bench_sendCommand(void)
+{
+	LCD_sendCommand(LCD_CURSOR_OFF);
+}
+
+static void Bench_displayCharacter(void)
+{
+	LCD_displayCharacter('A');
+}
+
+static void Bench_displayStringRowColumn(void)
+{
+	LCD_displayStringRowColumn(1, 0, "Please Enter");
+}
+
+static void Bench_displayStringRowColumn_P(void)
+{
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Please Enter"));
+}
+
+static void Bench_clearScreen(void)
+{
+	LCD_clearScreen();
+}
+
+static void Bench_bufferDisplayStringRowColumn(void)
+{
+	LCD_bufferDisplayStringRowColumn(0, 0, "Password: *****");
+}
+
+static void Bench_refresh(void)
+{
+	LCD_refresh();
+}
+
+static void Bench_processQueue(void)
+{
+	LCD_processQueue();
+}
+
+void Bench_runDriver(void)
+{
+	LCD_setTimeCallBack(Bench_getTimeUs);
+	Bench_measure("LCD_init", LCD_init);
+	Bench_measure("LCD_sendCommand", Bench_sendCommand);
+	Bench_measure("LCD_displayCharacter", Bench_displayCharacter);
+	Bench_measure("LCD_displayStringRowColumn", Bench_displayStringRowColumn);
+	Bench_measure("LCD_displayStringRowColumn_P", Bench_displayStringRowColumn_P);
+	Bench_measure("LCD_clearScreen", Bench_clearScreen);
+
+	/* The shadow buffer path: 15 changed cells queued, then one period of the queue */
+	Bench_measure("LCD_bufferDisplayStringRowColumn", Bench_bufferDisplayStringRowColumn);
+	Bench_measure("LCD_refresh", Bench_refresh);
+	Bench_measure("LCD_processQueue", Bench_processQueue);
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_motor.c
+ *
+ * Description: Operations of the DC motor and PWM drivers measured by the harness
+ * The speed is read from a volatile variable so the duty cycle conversion
+ * runs like it does for a speed computed by the application.
+ * PWM_floatDutyToCompare is the float conversion PWM_Timer0_Start used
+ * before, kept here only as the baseline of the fixed-point one.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "bench.h"
+#include "dc_motor.h"
+#include "pwm.h"
+#include <avr/io.h>
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static volatile uint8 g_speed = 50;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Bench_rotate(void)
+{
+	DcMotor_Rotate(CW, g_speed);
+}
+
+static void Bench_rampTo(void)
+{
+	DcMotor_RampTo(A_CW, g_speed);
+}
+
+static void Bench_dutyToCompare(void)
+{
+	OCR0 = PWM_DUTY_TO_COMPARE(g_speed);
+}
+
+static void PWM_floatDutyToCompare(void)
+{
+	OCR0 = g_speed * 2.55;
+}
+
+void Bench_runDriver(void)
+{
+	Bench_measure("DcMotor_Init", DcMotor_Init);
+	Bench_measure("DcMotor_Rotate", Bench_rotate);
+
+	/* Starts the ramp down before the reversal, the steps run from the software timer tick */
+	Bench_measure("DcMotor_RampTo", Bench_rampTo);
+
+	/* The duty cycle conversion alone, fixed-point against float */
+	Bench_measure("PWM_DUTY_TO_COMPARE", Bench_dutyToCompare);
+	Bench_measure("PWM_floatDutyToCompare", PWM_floatDutyToCompare);
+}
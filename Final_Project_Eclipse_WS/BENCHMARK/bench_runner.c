@@ -0,0 +1,246 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_runner.c
+ *
+ * Description: simavr runner of the benchmark ELFs, built for the host
+ *
+ *   bench_runner [-k] [-t seconds] bench_<driver>.elf
+ *
+ *   -k   hold the first keypad button (PB4 row wired to PB0 column)
+ *   -t   simulated time limit (default 10 seconds)
+ *
+ * Runs the ELF on an ATmega16 at 8MHz with a 24C16 EEPROM on the TWI bus
+ * and copies the UART output to stdout, until the harness sleeps with the
+ * interrupts disabled. The exit status is 1 if the ELF crashed or ran out of time.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "avr_ioport.h"
+#include "avr_twi.h"
+#include "avr_uart.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BENCH_MCU               "atmega16"
+#define BENCH_FREQUENCY         8000000UL
+
+#define EEPROM_DEVICE_ADDRESS   0XA0
+#define EEPROM_DEVICE_MASK      0XF0
+#define EEPROM_MEMORY_SIZE      2048
+#define EEPROM_PAGE_MASK        0X0F
+#define EEPROM_WRITE_CYCLE_US   5000
+
+/* 24C16 model: the block select bits of the address byte are the high memory address bits */
+typedef struct {
+	avr_t *avr;
+	avr_irq_t *irq;
+	uint8_t memory[EEPROM_MEMORY_SIZE];
+	uint8_t selected;
+	uint8_t word_address_set;
+	uint8_t written;
+	uint16_t address;
+	avr_cycle_count_t write_cycle_end;
+} Eeprom_ModelType;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static Eeprom_ModelType g_eeprom;
+
+static const char *g_eepromIrqNames[2] = {
+	[TWI_IRQ_INPUT] = "8>eeprom.out",
+	[TWI_IRQ_OUTPUT] = "32<eeprom.in",
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Uart_output(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	(void)irq;
+	(void)param;
+	putchar((int)value);
+}
+
+static void Eeprom_twiMessage(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	Eeprom_ModelType *eeprom_Ptr = param;
+	avr_twi_msg_irq_t message;
+
+	(void)irq;
+	message.u.v = value;
+
+	if (message.u.twi.msg & TWI_COND_STOP)
+	{
+		/* The page written is programmed at the stop bit */
+		if (eeprom_Ptr -> selected && eeprom_Ptr -> written)
+		{
+			eeprom_Ptr -> write_cycle_end = eeprom_Ptr -> avr -> cycle
+					+ avr_usec_to_cycles(eeprom_Ptr -> avr, EEPROM_WRITE_CYCLE_US);
+		}
+		eeprom_Ptr -> selected = 0;
+	}
+
+	if (message.u.twi.msg & TWI_COND_START)
+	{
+		eeprom_Ptr -> selected = 0;
+
+		/* The device is deaf during its write cycle, the address is not ACKed */
+		if ((message.u.twi.addr & EEPROM_DEVICE_MASK) == EEPROM_DEVICE_ADDRESS
+				&& eeprom_Ptr -> avr -> cycle >= eeprom_Ptr -> write_cycle_end)
+		{
+			eeprom_Ptr -> selected = message.u.twi.addr;
+			if (!(message.u.twi.addr & 0X01))
+			{
+				eeprom_Ptr -> address = (uint16_t)((message.u.twi.addr >> 1) & 0X07) << 8;
+				eeprom_Ptr -> word_address_set = 0;
+				eeprom_Ptr -> written = 0;
+			}
+			avr_raise_irq(eeprom_Ptr -> irq + TWI_IRQ_INPUT,
+					avr_twi_irq_msg(TWI_COND_ACK, eeprom_Ptr -> selected, 1));
+		}
+	}
+
+	if (!eeprom_Ptr -> selected)
+	{
+		return;
+	}
+
+	if (message.u.twi.msg & TWI_COND_WRITE)
+	{
+		avr_raise_irq(eeprom_Ptr -> irq + TWI_IRQ_INPUT,
+				avr_twi_irq_msg(TWI_COND_ACK, eeprom_Ptr -> selected, 1));
+
+		if (!eeprom_Ptr -> word_address_set)
+		{
+			eeprom_Ptr -> address |= message.u.twi.data;
+			eeprom_Ptr -> word_address_set = 1;
+		}
+		else
+		{
+			/* Bytes after the end of the page roll over to its start */
+			eeprom_Ptr -> memory[eeprom_Ptr -> address] = message.u.twi.data;
+			eeprom_Ptr -> address = (eeprom_Ptr -> address & ~EEPROM_PAGE_MASK)
+					| ((eeprom_Ptr -> address + 1) & EEPROM_PAGE_MASK);
+			eeprom_Ptr -> written = 1;
+		}
+	}
+
+	if (message.u.twi.msg & TWI_COND_READ)
+	{
+		avr_raise_irq(eeprom_Ptr -> irq + TWI_IRQ_INPUT,
+				avr_twi_irq_msg(TWI_COND_READ, eeprom_Ptr -> selected, eeprom_Ptr -> memory[eeprom_Ptr -> address]));
+		eeprom_Ptr -> address = (eeprom_Ptr -> address + 1) % EEPROM_MEMORY_SIZE;
+	}
+}
+
+static void Eeprom_attach(avr_t *avr, Eeprom_ModelType *eeprom_Ptr)
+{
+	memset(eeprom_Ptr, 0, sizeof(*eeprom_Ptr));
+	memset(eeprom_Ptr -> memory, 0XFF, sizeof(eeprom_Ptr -> memory));
+	eeprom_Ptr -> avr = avr;
+	eeprom_Ptr -> irq = avr_alloc_irq(&avr -> irq_pool, 0, 2, g_eepromIrqNames);
+
+	avr_irq_register_notify(eeprom_Ptr -> irq + TWI_IRQ_OUTPUT, Eeprom_twiMessage, eeprom_Ptr);
+	avr_connect_irq(eeprom_Ptr -> irq + TWI_IRQ_INPUT, avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+	avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), eeprom_Ptr -> irq + TWI_IRQ_OUTPUT);
+}
+
+int main(int argc, char *argv[])
+{
+	elf_firmware_t firmware;
+	avr_t *avr;
+	uint32_t uart_flags = 0;
+	avr_cycle_count_t end_cycle;
+	unsigned long seconds = 10;
+	int hold_key = 0;
+	int state = cpu_Running;
+	int option;
+
+	while ((option = getopt(argc, argv, "kt:")) != -1)
+	{
+		switch (option)
+		{
+		case 'k':
+			hold_key = 1;
+			break;
+		case 't':
+			seconds = strtoul(optarg, NULL, 10);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-k] [-t seconds] bench_<driver>.elf\n", argv[0]);
+			return 2;
+		}
+	}
+	if (optind != argc - 1)
+	{
+		fprintf(stderr, "usage: %s [-k] [-t seconds] bench_<driver>.elf\n", argv[0]);
+		return 2;
+	}
+
+	memset(&firmware, 0, sizeof(firmware));
+	if (elf_read_firmware(argv[optind], &firmware) != 0)
+	{
+		fprintf(stderr, "%s: can not read %s\n", argv[0], argv[optind]);
+		return 2;
+	}
+
+	avr = avr_make_mcu_by_name(BENCH_MCU);
+	if (avr == NULL)
+	{
+		fprintf(stderr, "%s: simavr has no %s core\n", argv[0], BENCH_MCU);
+		return 2;
+	}
+	avr_init(avr);
+	avr -> frequency = BENCH_FREQUENCY;
+	avr_load_firmware(avr, &firmware);
+
+	/* The UART bytes go to stdout as they are, not as simavr log lines */
+	avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &uart_flags);
+	uart_flags &= ~AVR_UART_FLAG_STDIO;
+	avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &uart_flags);
+	avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), Uart_output, NULL);
+
+	Eeprom_attach(avr, &g_eeprom);
+
+	if (hold_key)
+	{
+		/* The pressed button connects its row pin to its column pin */
+		avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), 4),
+				avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), 0));
+	}
+
+	end_cycle = avr_usec_to_cycles(avr, seconds * 1000000UL);
+	while (state != cpu_Done && state != cpu_Crashed && avr -> cycle < end_cycle)
+	{
+		state = avr_run(avr);
+	}
+	fflush(stdout);
+
+	if (state != cpu_Done)
+	{
+		fprintf(stderr, "%s: %s %s\n", argv[0], argv[optind], (state == cpu_Crashed) ? "crashed" : "ran out of time");
+		return 1;
+	}
+	return 0;
+}
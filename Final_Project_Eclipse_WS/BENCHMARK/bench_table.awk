@@ -0,0 +1,43 @@
+################################################################################
+#
+# Joins the BENCH lines of a harness run with the function sizes of its ELF
+#
+#   avr-nm -S --radix=d bench_<driver>.elf > symbols
+#   bench_runner bench_<driver>.elf | awk -v driver=<driver> -f bench_table.awk symbols -
+#
+# Prints one tab separated line per operation:
+#   driver  operation  cycles  stack_bytes  flash_bytes
+# Fails if the run has no END line or fewer BENCH lines than the operations
+# it measured, a result line mixed with other UART output would be lost.
+#
+# Author: Omar EL-Sheikh
+#
+################################################################################
+
+# avr-nm lines: address size type name, only the symbols that have a size
+FNR == NR {
+	if (NF == 4)
+		size[$4] = $2 + 0
+	next
+}
+
+$1 == "BENCH" {
+	printf "%s\t%s\t%s\t%s\t%s\n", driver, $2, $3, $4, ($2 in size) ? size[$2] : "-"
+	rows++
+}
+
+$1 == "END" {
+	measured = $2 + 0
+	ended = 1
+}
+
+END {
+	if (!ended) {
+		printf "%s: the benchmark did not end\n", driver > "/dev/stderr"
+		exit 1
+	}
+	if (rows != measured) {
+		printf "%s: %d result lines for %d operations measured\n", driver, rows, measured > "/dev/stderr"
+		exit 1
+	}
+}
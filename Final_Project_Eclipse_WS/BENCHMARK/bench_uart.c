@@ -0,0 +1,59 @@
+/***************************************************************************
+ *
+ * Module Name: Benchmark
+ *
+ * File Name: bench_uart.c
+ *
+ * Description: Operations of the UART driver measured by the harness
+ * The UART is already started by Bench_init in interrupt mode, so the
+ * measured writes only fill the TX buffer, the bytes are sent by the ISR.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "bench.h"
+#include "uart.h"
+#include <util/delay.h>
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+static void Bench_sendByte(void)
+{
+	UART_sendByte('U');
+}
+
+static void Bench_write(void)
+{
+	static const uint8 frame[16] = "0123456789ABCDEF";
+
+	UART_write(frame, sizeof(frame));
+}
+
+static void Bench_sendString(void)
+{
+	UART_sendString((const uint8 *)"Please Enter#");
+}
+
+static void Bench_tryReceive(void)
+{
+	uint8 data;
+
+	UART_tryReceive(&data);
+}
+
+void Bench_runDriver(void)
+{
+	/* Every write waits for the TX buffer to go out, so the next one starts empty */
+	Bench_measure("UART_sendByte", Bench_sendByte);
+	_delay_ms(BENCH_DRAIN_TIME_MS);
+	Bench_measure("UART_write", Bench_write);
+	_delay_ms(BENCH_DRAIN_TIME_MS);
+	Bench_measure("UART_sendString", Bench_sendString);
+	_delay_ms(BENCH_DRAIN_TIME_MS);
+	Bench_measure("UART_tryReceive", Bench_tryReceive);
+}
@@ -0,0 +1,54 @@
+#!/bin/sh
+################################################################################
+#
+# Size and cycle report of the Eclipse build profiles
+#
+# Builds both ECUs with every build configuration (Debug, Release, Speed, LTO)
+# and the driver benchmarks with the same optimization, then writes:
+#
+#   profile_sizes.tsv    profile, ecu, text, data, bss, flash_bytes, ram_bytes
+#   profile_cycles.tsv   profile, then the columns of results.tsv
+#
+# The ATmega16 has 16384 bytes of flash and 1024 bytes of RAM.
+# Needs the same tools as the Makefile, and avr-size.
+#
+# Author: Omar EL-Sheikh
+#
+################################################################################
+
+set -e
+
+cd "$(dirname "$0")"
+
+AVR_SIZE=${AVR_SIZE:-avr-size}
+ECUS="CONTROL_ECU HMI_ECU"
+
+# Profile name and the optimization of the benchmarks matching its configuration
+PROFILES="Debug:-O0 Release:-Os Speed:-O2 LTO:-Os_-flto"
+
+printf 'profile\tecu\ttext\tdata\tbss\tflash_bytes\tram_bytes\n' > profile_sizes.tsv
+printf 'profile\tdriver\toperation\tcycles\tstack_bytes\tflash_bytes\n' > profile_cycles.tsv
+
+for entry in $PROFILES
+do
+	profile=${entry%%:*}
+	opt=$(echo "${entry#*:}" | tr '_' ' ')
+
+	for ecu in $ECUS
+	do
+		make -C "../$ecu/$profile" all
+		"$AVR_SIZE" -A "../$ecu/$profile/$ecu.elf" | awk -v profile="$profile" -v ecu="$ecu" '
+			$1 == ".text" { text = $2 }
+			$1 == ".data" { data = $2 }
+			$1 == ".bss"  { bss = $2 }
+			END { printf "%s\t%s\t%d\t%d\t%d\t%d\t%d\n", profile, ecu, text, data, bss, text + data, data + bss }
+		' >> profile_sizes.tsv
+	done
+
+	make bench BUILD_DIR="build/$profile" OPT="$opt" RESULTS="build/$profile/results.tsv"
+	awk -v profile="$profile" 'NR > 1 { print profile "\t" $0 }' "build/$profile/results.tsv" >> profile_cycles.tsv
+done
+
+cat profile_sizes.tsv
+echo
+cat profile_cycles.tsv
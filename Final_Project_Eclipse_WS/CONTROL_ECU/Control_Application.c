@@ -22,12 +22,13 @@
 #include "twi.h"
 #include "external_eeprom.h"
 #include "uart.h"
-#include "timer1.h"
+#include "protocol.h"
+#include "soft_timer.h"
+#include "scheduler.h"
 #include "buzzer.h"
 #include "lcd.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <util/delay.h>
 
 /**************************************************************************
  *								 Definitions
@@ -36,11 +37,55 @@
 #define CONTROL_ECU_ADDRESS 0X01
 #define PASSWORD_SIZE 5
 #define PASSWORD_ENTER_KEY 13
-#define CONTROL_READY_TO_RECEIVE 0XAA
-#define HMI_READY_TO_RECEIVE 0XBB
 #define PASSWORD_CONFIRMED TRUE
 #define PASSWORD_UNCONFIRMED FALSE
+#define PASSWORD_NOT_CHECKED 2 /* The saved password could not be read, it is not a wrong password */
 #define EEPROM_PASSWORD_START_BYTE 0X0001
+#define MAX_PASSWORD_ERRORS 3
+
+/* Software timers IDs */
+#define DOOR_TIMER_ID 0
+#define LOCK_TIMER_ID 2
+/* DC_MOTOR_RAMP_TIMER_ID is taken by the motor ramps and BUZZER_TIMER_ID by the buzzer patterns */
+
+/* Door timings, a move includes its soft-start and soft-stop ramps */
+#define DOOR_UNLOCK_TIME_MS 15000
+#define DOOR_HOLD_TIME_MS 3000
+#define DOOR_LOCK_TIME_MS 15000
+#define DOOR_MOTOR_SPEED 50
+
+/* The soft-stop starts one ramp before the end of the move, also for a stalled closed-loop move */
+#define DOOR_MOVE_RUN_TIME_MS(move_time_ms) ((move_time_ms) - DC_MOTOR_RAMP_TIME_MS)
+
+/*
+ * Define DOOR_POSITION_FEEDBACK as 1 for a door with encoder and end-stops, the move ends at the door position
+ * and the door times above only limit a stalled move. Otherwise the door is moved for the door times
+ */
+#ifndef DOOR_POSITION_FEEDBACK
+#define DOOR_POSITION_FEEDBACK 0
+#endif
+
+/* Encoder positions of the door, the lock move is aimed past the lower end-stop to end there */
+#define DOOR_LOCKED_POSITION (-5)
+#define DOOR_OPEN_POSITION 340
+
+/* Alarm timings, the buzzer pattern of the lock lasts as long */
+#define SYSTEM_LOCK_TIME_MS 60000
+
+/**************************************************************************
+ *								 Types Declarations
+ *************************************************************************/
+
+/* Enumeration Constants for the Control ECU states */
+typedef enum {
+	STATE_CREATE_PASSWORD,   /* Waiting for a new password and its confirmation */
+	STATE_MAIN_OPTIONS,      /* Waiting for an option from the HMI ECU */
+	STATE_VERIFY_PASSWORD,   /* Waiting for the password of the chosen option */
+	STATE_DOOR_UNLOCKING,
+	STATE_DOOR_OPEN,
+	STATE_DOOR_LOCKING,
+	STATE_SYSTEM_LOCKED      /* Alarm is on after too many wrong passwords */
+} Control_State;
 
 /**************************************************************************
  *								 Global Variables
@@ -52,17 +97,24 @@ uint8 g_password[PASSWORD_SIZE];
 /* Global variable to store system password confirmation */
 uint8 g_passwordConfirm[PASSWORD_SIZE];
 
-/* Global variable to store confirmation of password status */
-boolean g_passwordConfirmStats = PASSWORD_UNCONFIRMED;
+/* Global variable to store the current state of the application */
+Control_State g_state = STATE_CREATE_PASSWORD;
+
+/* Global variable to store the option waiting for password verification */
+uint8 g_option;
+
+/* Global variable to count the wrong passwords of the current option */
+uint8 g_passwordErrorCount = 0;
 
-/* Global variable to store interrupts count for unlocking door */
-uint8 g_unlockDoorInt;
+/* Global variable set while a UART event is waiting in the scheduler queue */
+volatile boolean g_uartEventPending = FALSE;
 
-/* Global variable to store interrupts count for holding door */
-uint8 g_holdDoorInt;
+/* Global variable to store the time taken by the last door move in milliseconds */
+uint16 g_doorTravelTime = 0;
 
-/* Global variable to store interrupts count for locking door */
-uint8 g_lockDoorInt;
+/* Global variables to store the start of the door move, and if its soft-stop is running */
+uint32 g_doorMoveStartTicks = 0;
+boolean g_doorStopping = FALSE;
 
 /**************************************************************************
  *								Functions Prototypes
@@ -77,105 +129,139 @@ void Drivers_Init(void);
 /*
  * Description:
  * Function to check password and return state
+ * Returns PASSWORD_NOT_CHECKED if the saved password could not be read
  */
-boolean checkPassword(void);
+uint8 checkPassword(void);
 
 /* Description:
- * Function to receive password twice from HMI ECU
- * Confirm password
- * Send Confirmation to the HMI ECU
+ * Function to compare the received password and its confirmation
+ * Save the password and go to the main options if they match
+ * Send Confirmation to the HMI ECU only if the password is saved
  */
-void createPassword (void);
+void createPassword(const Protocol_FrameType * frame_Ptr);
 
 /*
  * Description:
- * Function to receive password by UART
+ * Function to send password confirmation status to HMI ECU
  */
-void receivePassword (uint8 * password_Ptr);
+void sendVerifyResult(uint8 status);
 
 /* Description:
  * Function to write the received password in the EEPROM
+ * Returns ERROR if the EEPROM write failed
  */
-void savePassword(void);
+uint8 savePassword(void);
 
 /* Description:
  * Function to activate buzzer and freeze system for 1 minute
  */
 void lockSystemAction(void);
 
-/*
- * Description:
- * Call-back function to process interrupt by the timer for unlocking door
- */
-void processUnlockDoor(void);
-
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to start unlocking the door, the move ends at the open position or after 15 seconds
  */
 void unlockDoor(void);
 
 /*
  * Description:
- * Function to process interrupt by timer in case of holding door
+ * Function to hold the door for 3 seconds
  */
-void processHoldDoor(void);
+void holdDoor(void);
 
 /*
  * Description:
- * Function to hold the door for 3 seconds
+ * Function to stop the door move with a soft-stop, the move ends after the ramp
  */
-void holdDoor(void);
+void stopDoor(void);
 
 /*
  * Description:
- * Call-back function to process interrupt by the timer for locking door
+ * Function to take the travel time of the door move that ended and go to the next door state
  */
-void processLockDoor(void);
+void doorMoveEnded(void);
+
+/*
+ * Description:
+ * Function to send the door state to the HMI ECU with the travel time of the last move
+ */
+void sendDoorState(Protocol_DoorState door_state);
 
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to start locking the door, the move ends at the lower end-stop or after 15 seconds
  */
 void lockDoor(void);
 
 /* Description:
- * Function to verify password in the EEPROM
+ * Function to verify the received password against the one in the EEPROM
+ * Take the action of the chosen option if it matches
  */
-void verifyPassword(void);
+void verifyPassword(const Protocol_FrameType * frame_Ptr);
 
 /* Description:
- * Function to take action in case user choose to open door
+ * Function to save the option received from HMI ECU until its password is verified
  */
-void openDoorAction(void);
+void processOption(const Protocol_FrameType * frame_Ptr);
 
 /*
  * Description:
- * Function to change system password
+ * Function to pass a received frame to the handler of the current state
  */
-void changePasswordProcess(void);
+void processFrame(const Protocol_FrameType * frame_Ptr);
 
-/* Description:
- * Function to receive option from HMI ECU and take an action based on it
+/*
+ * Description:
+ * Function to handle an expired software timer
+ */
+void processTimer(uint8 timer_id);
+
+/*
+ * Description:
+ * Function to handle the end of a closed-loop door move
  */
-void processOption(void);
+void processMotor(DcMotor_MoveResult result);
+
+/*
+ * Description:
+ * Function to handle one event from the scheduler
+ */
+void processEvent(const Scheduler_EventType * event_Ptr);
+
+/*
+ * Description:
+ * Call-back function of the software timers, runs in the Timer1 ISR
+ */
+void postTimerEvent(uint8 timer_id);
+
+/*
+ * Description:
+ * Call-back function of the UART RX, runs in the UART RXC ISR
+ */
+void postUartEvent(void);
+
+/*
+ * Description:
+ * Call-back function of the door moves, runs in the encoder or end-stop ISR
+ */
+void postMotorEvent(DcMotor_MoveResult result);
 
 /**************************************************************************
  *								Main Program Execution
  *************************************************************************/
 
 int main (){
-	sei(); /* Enabling Global Interrupt */
 	Drivers_Init();
+	sei(); /* Enabling Global Interrupt */
 
-	while (!g_passwordConfirmStats){
-		createPassword();
-	}
+	/* The first frame expected from the HMI ECU is the new password */
+	g_state = STATE_CREATE_PASSWORD;
 
-	/* Saving the password in EEPROM*/
-	savePassword();
+#ifdef SCHEDULER_POWER_STATS
+	/* The power build of the host port reads the measured time with Scheduler_reportPowerStats */
+	Scheduler_setPowerState(g_state);
+#endif
 
-	while (1){
-		processOption();
-	}
+	/* Program Flow */
+	Scheduler_run(processEvent);
 }
 
 /**************************************************************************
@@ -188,28 +274,39 @@ int main (){
  */
 void Drivers_Init(void){
 	/* Variable to store UART Configurations */
-	UART_ConfigType UART_Configs = {BITS_8, NO_PARITY, BIT_1, BAUD_RATE_9600};
+	UART_ConfigType UART_Configs = {BITS_8, NO_PARITY, BIT_1, BAUD_RATE_9600, UART_INTERRUPT_MODE};
 	/* Variable to store TWI Configurations */
 	TWI_ConfigType TWI_Configs = {CONTROL_ECU_ADDRESS, BIT_RATE_400_KBS};
 
+	Scheduler_init();
+	UART_setRxCallBack(postUartEvent);
 	UART_init(&UART_Configs);
 	TWI_init(&TWI_Configs);
+	SoftTimer_init();
 	DcMotor_Init();
+#if(DOOR_POSITION_FEEDBACK)
+	DcMotor_InitFeedback(postMotorEvent);
+#endif
 	Buzzer_init();
 }
 
 /*
  * Description:
  * Function to check password and return state
+ * Returns PASSWORD_NOT_CHECKED if the saved password could not be read
  */
-boolean checkPassword(void){
-	uint8 counter, temp;
+uint8 checkPassword(void){
+	uint8 counter;
+	uint8 savedPassword[PASSWORD_SIZE];
 
-	/* Checking password from EEPROM */
+	/* Reading the saved password from EEPROM in one sequential read */
+	if (EEPROM_readBlock(EEPROM_PASSWORD_START_BYTE, savedPassword, PASSWORD_SIZE) == ERROR){
+		return PASSWORD_NOT_CHECKED;
+	}
+
+	/* Checking password */
 	for (counter = 0; counter < PASSWORD_SIZE; counter++){
-		EEPROM_readByte(EEPROM_PASSWORD_START_BYTE + counter, &temp);
-		_delay_ms(10);
-		if (temp != g_password[counter]){
+		if (savedPassword[counter] != g_password[counter]){
 			return PASSWORD_UNCONFIRMED;
 		}
 	}
@@ -218,268 +315,360 @@ boolean checkPassword(void){
 }
 
 /* Description:
- * Function to receive password twice from HMI ECU
- * Confirm password
- * Send Confirmation to the HMI ECU
+ * Function to compare the received password and its confirmation
+ * Save the password and go to the main options if they match
+ * Send Confirmation to the HMI ECU only if the password is saved
  */
-void createPassword (void){
+void createPassword(const Protocol_FrameType * frame_Ptr){
 	uint8 i ;
 
-	/* Receive password */
-	receivePassword(&g_password);
-	/* Receive password again to be confirmed */
-	receivePassword(&g_passwordConfirm);
+	/* Password and its confirmation are received in one frame */
+	for (i = 0; i < PASSWORD_SIZE; i++){
+		g_password[i] = frame_Ptr -> payload[i];
+		g_passwordConfirm[i] = frame_Ptr -> payload[PASSWORD_SIZE + i];
+	}
 
 	/* Confirm Password */
 	for (i = 0; i < PASSWORD_SIZE; i++){
 		if (g_password [i] != g_passwordConfirm[i]){
-			/* Sending unconfirmation to indicate a mismatch */
-			while (UART_recieveByte() != HMI_READY_TO_RECEIVE){}
-			UART_sendByte(PASSWORD_UNCONFIRMED);
+			/* Sending unconfirmation to indicate a mismatch, the HMI ECU asks again */
+			sendVerifyResult(PASSWORD_UNCONFIRMED);
 			return;
 		}
 	}
 
+	/* Saving the password in EEPROM, a failed write is sent as a mismatch so the HMI ECU asks again */
+	if (savePassword() == ERROR){
+		sendVerifyResult(PASSWORD_UNCONFIRMED);
+		return;
+	}
+
 	/* Sending confirmation to indicate matching */
-	while (UART_recieveByte() != HMI_READY_TO_RECEIVE){}
-	UART_sendByte(PASSWORD_CONFIRMED);
-	g_passwordConfirmStats = PASSWORD_CONFIRMED;
+	sendVerifyResult(PASSWORD_CONFIRMED);
+	g_state = STATE_MAIN_OPTIONS;
 }
 
 /*
  * Description:
- * Function to receive password by UART
+ * Function to send password confirmation status to HMI ECU
  */
-void receivePassword (uint8 * password_Ptr){
-	uint8 counter ;
-
-	/* Sending an indicator that the Control ECU is ready to receive */
-	UART_sendByte(CONTROL_READY_TO_RECEIVE);
-
-	/* Receiving password by UART */
-	for (counter = 0; counter < PASSWORD_SIZE; counter ++){
-		password_Ptr [counter] = UART_recieveByte();
-	}
+void sendVerifyResult(uint8 status){
+	Protocol_sendFrame(PROTOCOL_MSG_VERIFY_RESULT, &status, 1);
 }
 
 /* Description:
  * Function to write the received password in the EEPROM
- */
-void savePassword(void){
-	uint8 counter;
-
-	/* Writing the password in 5 consecutive bytes in EEPROM  */
-	for (counter = 0; counter < PASSWORD_SIZE; counter++){
-		EEPROM_writeByte(EEPROM_PASSWORD_START_BYTE + counter, g_password[counter]);
-		_delay_ms(10);
-	}
+ * Returns ERROR if the EEPROM write failed
+ */
+uint8 savePassword(void){
+	/*
+	 * Writing the password in 5 consecutive bytes in EEPROM using page write
+	 * The next EEPROM access waits for the write cycle only if it is still running
+	 */
+	return EEPROM_writeBlock(EEPROM_PASSWORD_START_BYTE, g_password, PASSWORD_SIZE);
 }
 
 /* Description:
  * Function to activate buzzer and freeze system for 1 minute
  */
 void lockSystemAction(void){
-	uint8 counter;
-	Buzzer_on();
-	for (counter = 0; counter < 60; counter++){
-		_delay_ms(1000);
-	}
-	Buzzer_off();
-}
+	/* The lock alarm replaces the beep of the last wrong password */
+	Buzzer_play(BUZZER_PATTERN_SYSTEM_LOCKED);
 
-/*
- * Description:
- * Call-back function to process interrupt by the timer for unlocking door
- */
-void processUnlockDoor(void){
-	g_unlockDoorInt++;
+	/* Frames received while locked are discarded */
+	SoftTimer_start(LOCK_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(SYSTEM_LOCK_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_state = STATE_SYSTEM_LOCKED;
 }
 
-
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to start unlocking the door, the move ends at the open position or after 15 seconds
  */
 void unlockDoor(void){
-	g_unlockDoorInt = 0;
-
-	/* Configurations for Timer1 to generate an interrupt every 7.5 seconds */
-	Timer1_ConfigType Timer1_UnlockDoorConfigs = {0, 58594, F_CPU_1024, COMPARE_MODE};
-
-	/* Sending the specified call back function to unlock door to Timer1 ISR */
-	Timer1_setCallBack(processUnlockDoor);
-
-	/* Timer1 Initializing */
-	Timer1_init(&Timer1_UnlockDoorConfigs);
-
-	/* Rotating the motor CW */
-	DcMotor_Rotate(CW, 50);
-
-	/* Wait until Timer1 counts 15 seconds*/
-	while (g_unlockDoorInt != 2){}
-
-	/* Stopping the Timer */
-	Timer1_deInit();
-
-	/* Stopping the Motor */
-	DcMotor_Rotate(STOP, 0);
-
+	g_doorMoveStartTicks = SoftTimer_getTicks();
+	g_doorStopping = FALSE;
+	sendDoorState(PROTOCOL_DOOR_UNLOCKING);
+
+#if(DOOR_POSITION_FEEDBACK)
+	/* Moving the door to its open position, the door timer only stops a stalled move */
+	DcMotor_MoveTo(DOOR_OPEN_POSITION, DOOR_MOTOR_SPEED);
+#else
+	/* Rotating the motor CW with a soft-start */
+	DcMotor_RampTo(CW, DOOR_MOTOR_SPEED);
+#endif
+
+	SoftTimer_start(DOOR_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(DOOR_MOVE_RUN_TIME_MS(DOOR_UNLOCK_TIME_MS)), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_state = STATE_DOOR_UNLOCKING;
 }
 
 /*
  * Description:
- * Function to process interrupt by timer in case of holding door
+ * Function to hold the door for 3 seconds
  */
-void processHoldDoor(void){
-	g_holdDoorInt++;
+void holdDoor(void){
+	/* The motor is stopped, the HMI ECU shows the open door until the lock move starts */
+	sendDoorState(PROTOCOL_DOOR_OPEN);
+
+	SoftTimer_start(DOOR_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(DOOR_HOLD_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_state = STATE_DOOR_OPEN;
 }
 
 /*
  * Description:
- * Function to hold the door for 3 seconds
+ * Function to stop the door move with a soft-stop, the move ends after the ramp
  */
-void holdDoor(void){
-	g_holdDoorInt = 0;
-
-	/* Configurations for Timer1 to generate an interrupt every 3 seconds */
-	Timer1_ConfigType Timer1_HoldDoorConfigs = {0, 23438, F_CPU_1024, COMPARE_MODE};
-
-	/* Sending the specified call back function to door door to Timer1 ISR */
-	Timer1_setCallBack(processHoldDoor);
-
-	/* Stopping the Motor */
-	DcMotor_Rotate(STOP, 0);
+void stopDoor(void){
+	DcMotor_RampTo(STOP, 0);
+	g_doorStopping = TRUE;
 
-	/* Timer1 Initializing */
-	Timer1_init(&Timer1_HoldDoorConfigs);
+	SoftTimer_start(DOOR_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(DC_MOTOR_RAMP_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+}
 
-	/* Wait until Timer1 counts 3 seconds */
-	while (g_holdDoorInt != 1){}
+/*
+ * Description:
+ * Function to take the travel time of the door move that ended and go to the next door state
+ */
+void doorMoveEnded(void){
+	g_doorTravelTime = (uint16)((SoftTimer_getTicks() - g_doorMoveStartTicks) * SOFT_TIMER_TICK_MS);
 
-	/* Stopping the Timer */
-	Timer1_deInit();
+	if (g_state == STATE_DOOR_UNLOCKING){
+		holdDoor();
+	}
+	else{
+		sendDoorState(PROTOCOL_DOOR_LOCKED);
+		g_state = STATE_MAIN_OPTIONS;
+	}
 }
 
-
 /*
  * Description:
- * Call-back function to process interrupt by the timer for locking door
+ * Function to send the door state to the HMI ECU with the travel time of the last move
  */
-void processLockDoor(void){
-	g_lockDoorInt++;
-}
+void sendDoorState(Protocol_DoorState door_state){
+	uint8 payload[PROTOCOL_DOOR_STATE_PAYLOAD_SIZE];
 
+	/* Multi-byte fields are sent LSB first */
+	payload[0] = door_state;
+	payload[1] = (uint8)(g_doorTravelTime);
+	payload[2] = (uint8)(g_doorTravelTime >> 8);
+	Protocol_sendFrame(PROTOCOL_MSG_DOOR_STATE, payload, PROTOCOL_DOOR_STATE_PAYLOAD_SIZE);
+}
 
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to start locking the door, the move ends at the lower end-stop or after 15 seconds
  */
 void lockDoor(void){
-	g_lockDoorInt = 0;
-
-	/* Configurations for Timer1 to generate an interrupt every 7.5 seconds */
-	Timer1_ConfigType Timer1_lockDoorConfigs = {0, 58594, F_CPU_1024, COMPARE_MODE};
-
-	/* Sending the specified call back function to lock door to Timer1 ISR */
-	Timer1_setCallBack(processLockDoor);
+	g_doorMoveStartTicks = SoftTimer_getTicks();
+	g_doorStopping = FALSE;
+	sendDoorState(PROTOCOL_DOOR_LOCKING);
+
+#if(DOOR_POSITION_FEEDBACK)
+	/* Moving the door to its locked position, the door timer only stops a stalled move */
+	DcMotor_MoveTo(DOOR_LOCKED_POSITION, DOOR_MOTOR_SPEED);
+#else
+	/* Rotating the motor A_CW with a soft-start */
+	DcMotor_RampTo(A_CW, DOOR_MOTOR_SPEED);
+#endif
+
+	SoftTimer_start(DOOR_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(DOOR_MOVE_RUN_TIME_MS(DOOR_LOCK_TIME_MS)), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_state = STATE_DOOR_LOCKING;
+}
 
-	/* Timer1 Initializing */
-	Timer1_init(&Timer1_lockDoorConfigs);
+/* Description:
+ * Function to verify the received password against the one in the EEPROM
+ * Take the action of the chosen option if it matches
+ */
+void verifyPassword(const Protocol_FrameType * frame_Ptr){
+	uint8 counter;
+	uint8 status;
 
-	/* Rotating the motor A_CW */
-	DcMotor_Rotate(A_CW, 50);
+	for (counter = 0; counter < PASSWORD_SIZE; counter++){
+		g_password[counter] = frame_Ptr -> payload[counter];
+	}
+	status = checkPassword();
 
-	/* Wait until Timer1 counts 15 seconds*/
-	while (g_lockDoorInt != 2){}
+	/* Sending the result before the alarm so the HMI does not wait for it */
+	sendVerifyResult(status);
 
-	/* Stopping the Timer */
-	Timer1_deInit();
+	if (status == PASSWORD_NOT_CHECKED){
+		/* An EEPROM read error is not a wrong password, the HMI ECU asks for the password again */
+		return;
+	}
+	if (status == PASSWORD_CONFIRMED){
+		switch (g_option){
+		case '+' :
+			unlockDoor();
+			break;
+
+		case '-' :
+			/* The HMI ECU sends the new password next */
+			g_state = STATE_CREATE_PASSWORD;
+			break;
+		}
+		return;
+	}
 
-	/* Stopping the Motor */
-	DcMotor_Rotate(STOP, 0);
+	/* Activating the alarm if the password is wrong */
+	g_passwordErrorCount++;
+	if (g_passwordErrorCount == MAX_PASSWORD_ERRORS){
+		/* Locking the system if user entered 3 unmatched password */
+		lockSystemAction();
+		return;
+	}
+	Buzzer_play(BUZZER_PATTERN_WRONG_PASSWORD);
 }
 
 /* Description:
- * Function to verify password
+ * Function to save the option received from HMI ECU until its password is verified
  */
-void verifyPassword(void){
-	g_passwordConfirmStats = PASSWORD_UNCONFIRMED;
-	uint8 passwordErrorCount = 0;
+void processOption(const Protocol_FrameType * frame_Ptr){
+	switch (frame_Ptr -> payload[0]){
+	case '+' :
+	case '-' :
+		g_option = frame_Ptr -> payload[0];
+		g_passwordErrorCount = 0;
+		g_state = STATE_VERIFY_PASSWORD;
+		break;
+	}
+}
 
-	while (!g_passwordConfirmStats){
-		/* Locking the system if user entered 3 unmatched password */
-		if (passwordErrorCount == 3){
-			lockSystemAction();
-			return;
+/*
+ * Description:
+ * Function to pass a received frame to the handler of the current state
+ */
+void processFrame(const Protocol_FrameType * frame_Ptr){
+	switch (g_state){
+	case STATE_CREATE_PASSWORD :
+		if (frame_Ptr -> type == PROTOCOL_MSG_NEW_PASSWORD){
+			createPassword(frame_Ptr);
 		}
+		break;
 
-		/* Receive password */
-		receivePassword(&g_password);
-		g_passwordConfirmStats = checkPassword();
+	case STATE_MAIN_OPTIONS :
+		if (frame_Ptr -> type == PROTOCOL_MSG_OPTION){
+			processOption(frame_Ptr);
+		}
+		break;
 
-		/* Activating the alarm if the password is wrong */
-		if (!g_passwordConfirmStats){
-			passwordErrorCount++;
-			Buzzer_on();
-			_delay_ms(1000);
-			Buzzer_off();
+	case STATE_VERIFY_PASSWORD :
+		if (frame_Ptr -> type == PROTOCOL_MSG_PASSWORD){
+			verifyPassword(frame_Ptr);
 		}
+		break;
 
-		while (UART_recieveByte() != HMI_READY_TO_RECEIVE){}
-		UART_sendByte(g_passwordConfirmStats);
+	default :
+		/* Frames are not expected while the door moves or the system is locked */
+		break;
 	}
 }
 
+/*
+ * Description:
+ * Function to handle an expired software timer
+ */
+void processTimer(uint8 timer_id){
+	switch (timer_id){
+	case DOOR_TIMER_ID :
+		/*
+		 * The door timer is one-shot, it is not running when its own expiry is handled
+		 * If it runs, the event is from before the last restart and was already queued, as when
+		 * a move ended on its position at the same time, so acting on it would cut the new door time
+		 */
+		if (SoftTimer_isRunning(DOOR_TIMER_ID)){
+			break;
+		}
+		if (g_state == STATE_DOOR_UNLOCKING || g_state == STATE_DOOR_LOCKING){
+			/* The end of a timed move, or a stalled closed-loop move, is a soft-stop */
+			if (g_doorStopping){
+				doorMoveEnded();
+			}
+			else{
+				stopDoor();
+			}
+		}
+		else if (g_state == STATE_DOOR_OPEN){
+			lockDoor();
+		}
+		break;
 
-/* Description:
- * Function to take action in case user choose to open door
- */
-void openDoorAction(void){
+	case LOCK_TIMER_ID :
+		/* The lock alarm ends by itself */
+		g_state = STATE_MAIN_OPTIONS;
+		break;
+	}
+}
 
-	verifyPassword();
+/*
+ * Description:
+ * Function to handle the end of a closed-loop door move
+ */
+void processMotor(DcMotor_MoveResult result){
+	/* Both results end the move, the lower end-stop also resets the position in the motor driver */
+	(void)result;
 
-	if (g_passwordConfirmStats){
-		unlockDoor();
-		holdDoor();
-		lockDoor();
+	/* The door reached its position or an end-stop, the timer of a stalled move is not needed */
+	if ((g_state == STATE_DOOR_UNLOCKING || g_state == STATE_DOOR_LOCKING) && !g_doorStopping){
+		SoftTimer_stop(DOOR_TIMER_ID);
+		doorMoveEnded();
 	}
 }
 
 /*
  * Description:
- * Function to change system password
+ * Function to handle one event from the scheduler
  */
-void changePasswordProcess(void){
+void processEvent(const Scheduler_EventType * event_Ptr){
+	Protocol_FrameType frame;
 
-	verifyPassword();
+	switch (event_Ptr -> id){
+	case SCHEDULER_EVENT_UART_RX :
+		/* Bytes received after this point post a new event */
+		g_uartEventPending = FALSE;
+		while (Protocol_tryReceiveFrame(&frame)){
+			processFrame(&frame);
+		}
+		break;
 
-	if (g_passwordConfirmStats){
-		g_passwordConfirmStats = PASSWORD_UNCONFIRMED;
+	case SCHEDULER_EVENT_TIMER :
+		processTimer(event_Ptr -> param);
+		break;
 
-		while (!g_passwordConfirmStats){
-			createPassword();
-		}
-		savePassword();
+	case SCHEDULER_EVENT_MOTOR :
+		processMotor((DcMotor_MoveResult)event_Ptr -> param);
+		break;
+
+	default :
+		break;
 	}
-}
 
+#ifdef SCHEDULER_POWER_STATS
+	/* The time of this event is counted for the state it started in */
+	Scheduler_setPowerState(g_state);
+#endif
+}
 
-/* Description:
- * Function to receive option from HMI ECU and take an action based on it
+/*
+ * Description:
+ * Call-back function of the software timers, runs in the Timer1 ISR
  */
-void processOption(void){
-	uint8 option;
-	/* Sending an indicator that the Control ECU is ready to receive */
-	UART_sendByte(CONTROL_READY_TO_RECEIVE);
-	/* Receiving option from HMI ECU */
-	option = UART_recieveByte();
-
-	switch (option){
-	case '+' :
-		openDoorAction();
-		break;
+void postTimerEvent(uint8 timer_id){
+	Scheduler_postEvent(SCHEDULER_EVENT_TIMER, timer_id);
+}
 
-	case '-' :
-		changePasswordProcess();
-		break;
+/*
+ * Description:
+ * Call-back function of the UART RX, runs in the UART RXC ISR
+ */
+void postUartEvent(void){
+	/* One event is enough for all the bytes received before it is handled */
+	if (!g_uartEventPending){
+		g_uartEventPending = Scheduler_postEvent(SCHEDULER_EVENT_UART_RX, 0);
 	}
 }
 
+/*
+ * Description:
+ * Call-back function of the door moves, runs in the encoder or end-stop ISR
+ */
+void postMotorEvent(DcMotor_MoveResult result){
+	Scheduler_postEvent(SCHEDULER_EVENT_MOTOR, result);
+}
@@ -0,0 +1,51 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../../MCAL/lcd.c \
+../Control_Application.c \
+../buzzer.c \
+../dc_motor.c \
+../ext_int.c \
+../external_eeprom.c \
+../pwm.c \
+../twi.c 
+
+OBJS += \
+./Control_Application.o \
+./buzzer.o \
+./dc_motor.o \
+./ext_int.o \
+./external_eeprom.o \
+./lcd.o \
+./pwm.o \
+./twi.o 
+
+C_DEPS += \
+./Control_Application.d \
+./buzzer.d \
+./dc_motor.d \
+./ext_int.d \
+./external_eeprom.d \
+./lcd.d \
+./pwm.d \
+./twi.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+%.o: ../%.c subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -I".." -I"../../MCAL" -Wall -O2 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+lcd.o: ../../MCAL/lcd.c subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -I".." -I"../../MCAL" -Wall -O2 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
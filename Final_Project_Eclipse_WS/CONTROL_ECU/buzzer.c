@@ -17,6 +17,78 @@
  *******************************************************************************/
 #include "buzzer.h"
 #include "gpio.h"
+#include "soft_timer.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *								Definitions
+ *******************************************************************************/
+
+/*
+ * Pattern step byte: bit 7 is the buzzer level and bits 6:0 the step time in BUZZER_STEP_MS
+ * A zero byte ends the pattern, which is played again for its repeat count
+ */
+#define BUZZER_ON_STEP(ms) (0X80 | ((ms) / BUZZER_STEP_MS))
+#define BUZZER_OFF_STEP(ms) ((ms) / BUZZER_STEP_MS)
+#define BUZZER_END_STEP 0
+
+#define BUZZER_STEP_LEVEL_MASK 0X80
+#define BUZZER_STEP_TIME_MASK 0X7F
+
+/*******************************************************************************
+ *								Types Declaration
+ *******************************************************************************/
+
+/* Structure Data Type to define one pattern of the pattern table */
+typedef struct {
+	uint8 first_step;  /* Index of its first step in g_patternSteps */
+	uint8 repeats;     /* Times the steps are played */
+} Buzzer_PatternType;
+
+/*******************************************************************************
+ *								Global Variables
+ *******************************************************************************/
+
+/* Steps of all the patterns, each one ends with BUZZER_END_STEP */
+static const uint8 g_patternSteps[] PROGMEM = {
+	/* BUZZER_PATTERN_WRONG_PASSWORD */
+	BUZZER_ON_STEP(1000), BUZZER_END_STEP,
+	/* BUZZER_PATTERN_SYSTEM_LOCKED, played 60 times */
+	BUZZER_ON_STEP(1000), BUZZER_END_STEP
+};
+
+/* Pattern table, in the order of Buzzer_PatternId */
+static const Buzzer_PatternType g_patterns[] PROGMEM = {
+	{0, 1},
+	{2, 60}
+};
+
+/* Step playing now, the first step of its pattern and the repeats left after this one */
+static uint8 g_step = 0;
+static uint8 g_firstStep = 0;
+static uint8 g_repeatsLeft = 0;
+
+static volatile boolean g_playing = FALSE;
+
+/*******************************************************************************
+ *								Functions Prototypes(Private)
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to play the current step, or the pattern again, or end the pattern at its end
+ * Interrupts must be disabled by the caller
+ */
+static void Buzzer_playStep(void);
+
+/*
+ * Description:
+ * Call-back function of the pattern timer, runs in the Timer1 ISR and goes to the next step
+ */
+static void Buzzer_nextStep(uint8 timer_id);
+
 /*******************************************************************************
  *								Functions Definitions
  *******************************************************************************/
@@ -31,3 +103,66 @@ void Buzzer_on(void){
 void Buzzer_off(void){
 	GPIO_writePin(BUZZER_PORT, BUZZER_PIN, LOGIC_LOW);
 }
+
+void Buzzer_play(Buzzer_PatternId pattern_id){
+	uint8 sreg;
+
+	/* The pattern state is shared with the Timer1 ISR */
+	sreg = SREG;
+	cli();
+
+	g_firstStep = pgm_read_byte(&g_patterns[pattern_id].first_step);
+	g_repeatsLeft = pgm_read_byte(&g_patterns[pattern_id].repeats) - 1;
+	g_step = g_firstStep;
+	g_playing = TRUE;
+	Buzzer_playStep();
+
+	SREG = sreg;
+}
+
+void Buzzer_stop(void){
+	uint8 sreg;
+
+	sreg = SREG;
+	cli();
+	SoftTimer_stop(BUZZER_TIMER_ID);
+	g_playing = FALSE;
+	Buzzer_off();
+	SREG = sreg;
+}
+
+boolean Buzzer_isPlaying(void){
+	return g_playing;
+}
+
+static void Buzzer_playStep(void){
+	uint8 step = pgm_read_byte(&g_patternSteps[g_step]);
+
+	if (step == BUZZER_END_STEP){
+		if (g_repeatsLeft == 0){
+			SoftTimer_stop(BUZZER_TIMER_ID);
+			g_playing = FALSE;
+			Buzzer_off();
+			return;
+		}
+		g_repeatsLeft--;
+		g_step = g_firstStep;
+		step = pgm_read_byte(&g_patternSteps[g_step]);
+	}
+
+	/* Writing the same level again between two steps makes no edge on the pin */
+	if (step & BUZZER_STEP_LEVEL_MASK){
+		Buzzer_on();
+	}
+	else{
+		Buzzer_off();
+	}
+	SoftTimer_start(BUZZER_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(BUZZER_STEP_MS) * (step & BUZZER_STEP_TIME_MASK),
+			SOFT_TIMER_ONE_SHOT, Buzzer_nextStep);
+}
+
+static void Buzzer_nextStep(uint8 timer_id){
+	(void)timer_id;
+	g_step++;
+	Buzzer_playStep();
+}
@@ -26,6 +26,22 @@
 #define BUZZER_PORT PORTA_ID
 #define BUZZER_PIN PIN0_ID
 
+/* Software timer playing the patterns, the application must not use this ID */
+#define BUZZER_TIMER_ID 6
+
+/* Time unit of the pattern steps */
+#define BUZZER_STEP_MS 50
+
+/*******************************************************************************
+ *								Types Declaration
+ *******************************************************************************/
+
+/* Enumeration Constants to define the patterns of the pattern table in buzzer.c */
+typedef enum {
+	BUZZER_PATTERN_WRONG_PASSWORD, /* One second beep */
+	BUZZER_PATTERN_SYSTEM_LOCKED   /* One minute alarm */
+} Buzzer_PatternId;
+
 /*******************************************************************************
  *								Functions Prototypes
  *******************************************************************************/
@@ -46,4 +62,24 @@ void Buzzer_on(void);
  * Function to disable Buzzer
  */
 void Buzzer_off(void);
+
+/*
+ * Description:
+ * Function to play the given pattern in the background, it returns at once
+ * The steps are played from the software timer tick, SoftTimer_init must be called before it
+ * A pattern started while another one plays replaces it
+ */
+void Buzzer_play(Buzzer_PatternId pattern_id);
+
+/*
+ * Description:
+ * Function to stop the pattern playing and disable Buzzer
+ */
+void Buzzer_stop(void);
+
+/*
+ * Description:
+ * Function to check if a pattern is playing
+ */
+boolean Buzzer_isPlaying(void);
 #endif /* BUZZER_H_ */
@@ -18,6 +18,121 @@
 #include "dc_motor.h"
 #include "common_macros.h"
 #include "gpio.h"
+#include "pwm.h"
+#include "soft_timer.h"
+#include "ext_int.h"
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+/***************************************************************************
+ *								Definitions
+ ***************************************************************************/
+
+/* Steps of one ramp, given by the profile table */
+#define DC_MOTOR_RAMP_STEPS 16
+
+/* Software timer ticks between two ramp steps */
+#define DC_MOTOR_RAMP_STEP_TICKS SOFT_TIMER_MS_TO_TICKS(DC_MOTOR_RAMP_TIME_MS / DC_MOTOR_RAMP_STEPS)
+
+/***************************************************************************
+ *								Global Variables
+ ***************************************************************************/
+
+/*
+ * Fraction of the ramp done after each step out of 256, the last step is the target speed itself
+ * The S-curve is 3t^2 - 2t^3 which starts and ends the ramp with no jump in acceleration
+ */
+static const uint8 g_rampProfile[DC_MOTOR_RAMP_STEPS - 1] PROGMEM = {
+#if(DC_MOTOR_RAMP_PROFILE == DC_MOTOR_RAMP_S_CURVE)
+	3, 11, 24, 40, 59, 81, 104, 128, 152, 175, 197, 216, 232, 245, 253
+#else
+	16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240
+#endif
+};
+
+/* Direction and speed the motor is driven with now */
+static DcMotor_State g_motorState = STOP;
+static uint8 g_motorSpeed = 0;
+
+/* Direction and speed the ramps end at */
+static DcMotor_State g_targetState = STOP;
+static uint8 g_targetSpeed = 0;
+
+/* Speeds of the current ramp and its last step done */
+static uint8 g_rampStartSpeed = 0;
+static uint8 g_rampEndSpeed = 0;
+static uint8 g_rampStep = 0;
+
+static volatile boolean g_ramping = FALSE;
+
+/* Encoder position, and the count added by each pulse in the last direction driven */
+static volatile sint16 g_position = 0;
+static sint8 g_encoderStep = 1;
+
+/* Closed-loop move in progress, its target, and the speed it runs at */
+static volatile boolean g_moving = FALSE;
+static DcMotor_State g_moveState = STOP;
+static sint16 g_moveTarget = 0;
+static uint8 g_moveSpeed = 0;
+static uint32 g_moveStartTicks = 0;
+static uint16 g_travelTime = 0;
+
+static void (*volatile g_moveCallBack)(DcMotor_MoveResult result) = NULL_PTR;
+
+/***************************************************************************
+ *								Functions Prototypes(Private)
+ ***************************************************************************/
+
+/*
+ * Description:
+ * Function to write the direction pins of the given state
+ * */
+static void DcMotor_setDirection(DcMotor_State state);
+
+/*
+ * Description:
+ * Function to start the next ramp towards the target, or end the ramping if it is reached
+ * A ramp in the old direction goes down to zero before the direction is changed
+ * Interrupts must be disabled by the caller
+ * */
+static void DcMotor_nextRamp(void);
+
+/*
+ * Description:
+ * Call-back function of the ramp timer, runs in the Timer1 ISR and does one ramp step
+ * */
+static void DcMotor_rampStep(uint8 timer_id);
+
+/*
+ * Description:
+ * Function to drive the motor at once with the given state and speed, dropping a ramp in progress
+ * */
+static void DcMotor_drive(DcMotor_State state,uint8 speed);
+
+/*
+ * Description:
+ * Function to start ramping to the given state and speed
+ * */
+static void DcMotor_startRamp(DcMotor_State state,uint8 speed);
+
+/*
+ * Description:
+ * Function to end the closed-loop move with the given result and call the call-back function
+ * Runs in the encoder or end-stop ISR
+ * */
+static void DcMotor_endMove(DcMotor_MoveResult result);
+
+/*
+ * Description:
+ * Call-back function of the encoder interrupt, counts one pulse and controls the move speed
+ * */
+static void DcMotor_encoderPulse(void);
+
+/*
+ * Description:
+ * Call-back function of the end-stop interrupt, stops the move at once
+ * */
+static void DcMotor_endStopHit(void);
 
 /***************************************************************************
  *								Functions Definitions
@@ -40,6 +155,9 @@ void DcMotor_Init(void){
 	 * */
 	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN1, LOGIC_LOW);
 	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN2, LOGIC_LOW);
+
+	/* The PWM runs from the start, the ramps only change its duty cycle */
+	PWM_Timer0_Start(0);
 }
 
 /*
@@ -48,17 +166,264 @@ void DcMotor_Init(void){
  * Sets the speed of the motor based on the required PWM signal sent
  * */
 void DcMotor_Rotate(DcMotor_State state,uint8 speed){
-	/*
-	 * Clearing the motor direction pins
-	 * */
-	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN1, LOGIC_LOW);
-	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN2, LOGIC_LOW);
+	/* A move in progress is cancelled */
+	g_moving = FALSE;
+	DcMotor_drive(state, speed);
+}
+
+/*
+ * Description:
+ * Function to move the DC Motor to the given state and speed along the ramp profile
+ * It returns at once, the speed is stepped from the software timer tick
+ * */
+void DcMotor_RampTo(DcMotor_State state,uint8 speed){
+	/* A move in progress is cancelled */
+	g_moving = FALSE;
+	DcMotor_startRamp(state, speed);
+}
+
+/*
+ * Description:
+ * Function to check if the DC Motor speed is still ramping
+ * */
+boolean DcMotor_IsRamping(void){
+	return g_ramping;
+}
+
+/*
+ * Description:
+ * Function to enable the encoder and end-stop interrupts for the closed-loop moves
+ * The call-back function is called from the ISR when a move ends, with its result
+ * */
+void DcMotor_InitFeedback(void(*a_ptr)(DcMotor_MoveResult result)){
+	/* The encoder and the end-stop switches pull their pins low, the internal pull-ups are used */
+	ExtInt_ConfigType Encoder_Configs = {DC_MOTOR_ENCODER_INT, RISING_EDGE, TRUE};
+	ExtInt_ConfigType EndStop_Configs = {DC_MOTOR_END_STOP_INT, FALLING_EDGE, TRUE};
+
+	g_moveCallBack = a_ptr;
+	ExtInt_setCallBack(DC_MOTOR_ENCODER_INT, DcMotor_encoderPulse);
+	ExtInt_setCallBack(DC_MOTOR_END_STOP_INT, DcMotor_endStopHit);
+	ExtInt_init(&Encoder_Configs);
+	ExtInt_init(&EndStop_Configs);
+}
+
+/*
+ * Description:
+ * Function to move the DC Motor to the given encoder position and stop there, it returns at once
+ * */
+void DcMotor_MoveTo(sint16 position,uint8 speed){
+	uint8 sreg;
+	uint16 distance;
+	DcMotor_State state;
+
+	/* The move is shared with the encoder and end-stop ISRs */
+	sreg = SREG;
+	cli();
+
+	if (position > g_position){
+		distance = position - g_position;
+		state = CW;
+	}
+	else{
+		distance = g_position - position;
+		state = A_CW;
+	}
+
+	g_moveState = state;
+	g_moveTarget = position;
+	g_moveSpeed = speed;
+	g_moveStartTicks = SoftTimer_getTicks();
+	g_moving = TRUE;
+
+	if (distance == 0){
+		DcMotor_endMove(MOVE_AT_TARGET);
+	}
+	else{
+		/* A short move runs at the creep speed all the way */
+		DcMotor_startRamp(state, (distance > DC_MOTOR_SLOW_DOWN_PULSES) ? speed : DC_MOTOR_CREEP_SPEED);
+	}
+
+	SREG = sreg;
+}
+
+/*
+ * Description:
+ * Function to return the encoder position
+ * */
+sint16 DcMotor_GetPosition(void){
+	uint8 sreg;
+	sint16 position;
+
+	/* 16-bit read must not be split by the encoder ISR */
+	sreg = SREG;
+	cli();
+	position = g_position;
+	SREG = sreg;
+
+	return position;
+}
+
+/*
+ * Description:
+ * Function to return the time taken by the last move that ended, in milliseconds
+ * */
+uint16 DcMotor_GetTravelTime(void){
+	uint8 sreg;
+	uint16 travel_time;
+
+	sreg = SREG;
+	cli();
+	travel_time = g_travelTime;
+	SREG = sreg;
+
+	return travel_time;
+}
+
+static void DcMotor_drive(DcMotor_State state,uint8 speed){
+	uint8 sreg;
+
+	/* A ramp in progress is dropped */
+	sreg = SREG;
+	cli();
+	SoftTimer_stop(DC_MOTOR_RAMP_TIMER_ID);
+	g_ramping = FALSE;
+	g_motorState = g_targetState = state;
+	g_motorSpeed = g_targetSpeed = speed;
 
 	/*Setting the motor direction pins in PORTB to the specified state*/
-	PORTB |= (state);
+	DcMotor_setDirection(state);
+	SREG = sreg;
 
 	/*
 	 * Sending the specified speed value to TIMER0 to generate a PWM signal
 	 * on PC0 which will control the motor speed */
 	PWM_Timer0_Start(speed);
 }
+
+static void DcMotor_startRamp(DcMotor_State state,uint8 speed){
+	uint8 sreg;
+
+	if (speed > PWM_MAX_DUTY_CYCLE){
+		speed = PWM_MAX_DUTY_CYCLE;
+	}
+
+	/* The ramp state is shared with the Timer1 ISR */
+	sreg = SREG;
+	cli();
+
+	g_targetState = state;
+	g_targetSpeed = (state == STOP) ? 0 : speed;
+
+	/* A new target restarts the ramping from the current speed */
+	SoftTimer_stop(DC_MOTOR_RAMP_TIMER_ID);
+	DcMotor_nextRamp();
+
+	SREG = sreg;
+}
+
+static void DcMotor_setDirection(DcMotor_State state){
+	/* The encoder pulses count in the last direction driven, also while the motor coasts */
+	if (state == CW){
+		g_encoderStep = 1;
+	}
+	else if (state == A_CW){
+		g_encoderStep = -1;
+	}
+
+	/*
+	 * Clearing the motor direction pins
+	 * */
+	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN1, LOGIC_LOW);
+	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN2, LOGIC_LOW);
+
+	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN1, GET_BIT(state, 0));
+	GPIO_writePin(PORTB_ID, MOTOR_PIN_IN2, GET_BIT(state, 1));
+}
+
+static void DcMotor_nextRamp(void){
+	/* The direction is changed only when the motor is stopped */
+	if (g_motorState != g_targetState){
+		if (g_motorSpeed == 0){
+			g_motorState = g_targetState;
+			DcMotor_setDirection(g_motorState);
+		}
+		else{
+			g_rampEndSpeed = 0;
+		}
+	}
+	if (g_motorState == g_targetState){
+		g_rampEndSpeed = g_targetSpeed;
+	}
+
+	if (g_rampEndSpeed == g_motorSpeed){
+		g_ramping = FALSE;
+		return;
+	}
+
+	g_rampStartSpeed = g_motorSpeed;
+	g_rampStep = 0;
+	g_ramping = TRUE;
+	SoftTimer_start(DC_MOTOR_RAMP_TIMER_ID, DC_MOTOR_RAMP_STEP_TICKS, SOFT_TIMER_PERIODIC, DcMotor_rampStep);
+}
+
+static void DcMotor_rampStep(uint8 timer_id){
+	sint16 change;
+
+	g_rampStep++;
+	if (g_rampStep == DC_MOTOR_RAMP_STEPS){
+		g_motorSpeed = g_rampEndSpeed;
+	}
+	else{
+		change = (sint16)g_rampEndSpeed - g_rampStartSpeed;
+		g_motorSpeed = g_rampStartSpeed + (sint8)((change * pgm_read_byte(&g_rampProfile[g_rampStep - 1])) >> 8);
+	}
+	PWM_Timer0_setDutyCycle(g_motorSpeed);
+
+	if (g_rampStep == DC_MOTOR_RAMP_STEPS){
+		SoftTimer_stop(timer_id);
+		DcMotor_nextRamp();
+	}
+}
+
+static void DcMotor_endMove(DcMotor_MoveResult result){
+	g_moving = FALSE;
+	g_travelTime = (uint16)((SoftTimer_getTicks() - g_moveStartTicks) * SOFT_TIMER_TICK_MS);
+
+	if (g_moveCallBack != NULL_PTR){
+		(*g_moveCallBack)(result);
+	}
+}
+
+static void DcMotor_encoderPulse(void){
+	sint16 distance;
+
+	g_position += g_encoderStep;
+	if (!g_moving){
+		return;
+	}
+
+	/* Pulses of the motor still coasting the other way make the distance grow */
+	distance = (g_moveState == CW) ? (g_moveTarget - g_position) : (g_position - g_moveTarget);
+	if (distance <= 0){
+		/* The motor is at the creep speed, it is cut at once */
+		DcMotor_drive(STOP, 0);
+		DcMotor_endMove(MOVE_AT_TARGET);
+	}
+	else if (distance == DC_MOTOR_SLOW_DOWN_PULSES && g_moveSpeed > DC_MOTOR_CREEP_SPEED){
+		DcMotor_startRamp(g_moveState, DC_MOTOR_CREEP_SPEED);
+	}
+}
+
+static void DcMotor_endStopHit(void){
+	/* The door can not go further, the end-stop is reached while the motor pushes into it */
+	if (!g_moving){
+		return;
+	}
+	DcMotor_drive(STOP, 0);
+
+	/* The lower end-stop sets the position again, the encoder may miss pulses */
+	if (g_encoderStep < 0){
+		g_position = 0;
+	}
+	DcMotor_endMove(MOVE_AT_END_STOP);
+}
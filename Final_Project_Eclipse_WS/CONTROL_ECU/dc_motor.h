@@ -26,6 +26,31 @@
 #define MOTOR_PIN_IN1 PB0
 #define MOTOR_PIN_IN2 PB1
 
+/* Ramp profiles, the speed follows a straight line or an S-curve between two speeds */
+#define DC_MOTOR_RAMP_TRAPEZOIDAL 0
+#define DC_MOTOR_RAMP_S_CURVE 1
+
+#ifndef DC_MOTOR_RAMP_PROFILE
+#define DC_MOTOR_RAMP_PROFILE DC_MOTOR_RAMP_S_CURVE
+#endif
+
+/* Time of one ramp from any speed to any other speed, a reversal takes two ramps */
+#define DC_MOTOR_RAMP_TIME_MS 800
+
+/* Software timer stepping the ramps, the application must not use this ID */
+#define DC_MOTOR_RAMP_TIMER_ID 5
+
+/*
+ * Closed-loop moves: the encoder pulses on INT0 (PD2) count the position, CW counts up
+ * Both end-stop switches pull INT1 (PD3) low, the lower end-stop is position 0
+ */
+#define DC_MOTOR_ENCODER_INT EXT_INT0
+#define DC_MOTOR_END_STOP_INT EXT_INT1
+
+/* The move slows down to the creep speed this many pulses before its target */
+#define DC_MOTOR_SLOW_DOWN_PULSES 80
+#define DC_MOTOR_CREEP_SPEED 20
+
 /***************************************************************************
 *								Types Declaration
 ***************************************************************************/
@@ -33,6 +58,10 @@ typedef enum DcMotor_State {
 	STOP, A_CW, CW
 } DcMotor_State;
 
+typedef enum DcMotor_MoveResult {
+	MOVE_AT_TARGET, MOVE_AT_END_STOP
+} DcMotor_MoveResult;
+
 /***************************************************************************
 *								Functions Prototypes
 ***************************************************************************/
@@ -51,4 +80,48 @@ void DcMotor_Init(void);
  * */
 void DcMotor_Rotate(DcMotor_State state,uint8 speed);
 
+/*
+ * Description:
+ * Function to move the DC Motor to the given state and speed along the ramp profile
+ * It returns at once, the speed is stepped from the software timer tick
+ * A stop ramps the speed down to zero before clearing the direction pins
+ * A change of direction ramps down to zero first, then ramps up in the new direction
+ * SoftTimer_init must be called before it
+ * */
+void DcMotor_RampTo(DcMotor_State state,uint8 speed);
+
+/*
+ * Description:
+ * Function to check if the DC Motor speed is still ramping
+ * */
+boolean DcMotor_IsRamping(void);
+
+/*
+ * Description:
+ * Function to enable the encoder and end-stop interrupts for the closed-loop moves
+ * The call-back function is called from the ISR when a move ends, with its result
+ * */
+void DcMotor_InitFeedback(void(*a_ptr)(DcMotor_MoveResult result));
+
+/*
+ * Description:
+ * Function to move the DC Motor to the given encoder position and stop there, it returns at once
+ * The speed ramps up, drops to DC_MOTOR_CREEP_SPEED near the target and is cut at the target
+ * An end-stop cuts the motor at once and ends the move early
+ * DcMotor_Rotate or DcMotor_RampTo cancel a move without calling the call-back function
+ * */
+void DcMotor_MoveTo(sint16 position,uint8 speed);
+
+/*
+ * Description:
+ * Function to return the encoder position
+ * */
+sint16 DcMotor_GetPosition(void);
+
+/*
+ * Description:
+ * Function to return the time taken by the last move that ended, in milliseconds
+ * */
+uint16 DcMotor_GetTravelTime(void);
+
 #endif /* DC_MOTOR_H_ */
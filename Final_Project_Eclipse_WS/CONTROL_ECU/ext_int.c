@@ -0,0 +1,88 @@
+/***************************************************************************
+ *
+ * Module Name: External Interrupts
+ * 	 
+ * File Name: ext_int.c
+ *
+ * Description: Source file for the ATmega16 External Interrupts (INT0, INT1) Driver
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ * 
+ **************************************************************************/
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "ext_int.h"
+#include "common_macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ * 								 Global Variables
+ *******************************************************************************/
+static void (*volatile g_ExtInt0_Call_Back) (void) = NULL_PTR;
+static void (*volatile g_ExtInt1_Call_Back) (void) = NULL_PTR;
+
+/*******************************************************************************
+ * 								 Functions Definitions
+ *******************************************************************************/
+void ExtInt_init(const ExtInt_ConfigType * Config_Ptr){
+	if (Config_Ptr -> id == EXT_INT0){
+		/* Setting INT0 pin as input, with the internal pull-up if required */
+		GPIO_setupPinDirection(EXT_INT_PORT_ID, EXT_INT0_PIN_ID, PIN_INPUT);
+		GPIO_writePin(EXT_INT_PORT_ID, EXT_INT0_PIN_ID, Config_Ptr -> pull_up ? LOGIC_HIGH : LOGIC_LOW);
+
+		/* Setting the sense control in ISC01:00, then clearing the flag of an old edge (written to one) */
+		MCUCR = (MCUCR & 0XFC) | (Config_Ptr -> sense);
+		GIFR = (1 << INTF0);
+		SET_BIT(GICR, INT0); /* External Interrupt Request 0 Enable */
+	}
+	else{
+		/* Setting INT1 pin as input, with the internal pull-up if required */
+		GPIO_setupPinDirection(EXT_INT_PORT_ID, EXT_INT1_PIN_ID, PIN_INPUT);
+		GPIO_writePin(EXT_INT_PORT_ID, EXT_INT1_PIN_ID, Config_Ptr -> pull_up ? LOGIC_HIGH : LOGIC_LOW);
+
+		/* Setting the sense control in ISC11:10, then clearing the flag of an old edge (written to one) */
+		MCUCR = (MCUCR & 0XF3) | ((Config_Ptr -> sense) << 2);
+		GIFR = (1 << INTF1);
+		SET_BIT(GICR, INT1); /* External Interrupt Request 1 Enable */
+	}
+}
+
+void ExtInt_setCallBack(ExtInt_Id id, void(*a_ptr)(void)){
+	/* Saving the address of the call back function in a global pointer to function*/
+	if (id == EXT_INT0){
+		g_ExtInt0_Call_Back = a_ptr;
+	}
+	else{
+		g_ExtInt1_Call_Back = a_ptr;
+	}
+}
+
+void ExtInt_deInit(ExtInt_Id id){
+	if (id == EXT_INT0){
+		CLEAR_BIT(GICR, INT0);
+	}
+	else{
+		CLEAR_BIT(GICR, INT1);
+	}
+}
+
+ISR (INT0_vect){
+	if(g_ExtInt0_Call_Back != NULL_PTR)
+	{
+		/* Calling the Call Back function in the application on the INT0 edge */
+		(*g_ExtInt0_Call_Back)();
+	}
+}
+
+ISR (INT1_vect){
+	if(g_ExtInt1_Call_Back != NULL_PTR)
+	{
+		/* Calling the Call Back function in the application on the INT1 edge */
+		(*g_ExtInt1_Call_Back)();
+	}
+}
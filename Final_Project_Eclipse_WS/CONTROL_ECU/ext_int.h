@@ -0,0 +1,76 @@
+/***************************************************************************
+ *
+ * Module Name: External Interrupts
+ * 	 
+ * File Name: ext_int.h
+ *
+ * Description: Header file for the ATmega16 External Interrupts (INT0, INT1) Driver
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ * 
+ **************************************************************************/
+#ifndef EXT_INT_H_
+#define EXT_INT_H_
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "std_types.h"
+#include "gpio.h"
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+
+/* Pins of the external interrupts */
+#define EXT_INT_PORT_ID PORTD_ID
+#define EXT_INT0_PIN_ID PIN2_ID
+#define EXT_INT1_PIN_ID PIN3_ID
+
+/*******************************************************************************
+ * 								 User-Defined Data Types
+ *******************************************************************************/
+
+/* Enumeration Constants to define the external interrupts */
+typedef enum {
+	EXT_INT0, EXT_INT1
+} ExtInt_Id;
+
+/* Enumeration Constants to define the interrupt sense control, same values as the ISC bits */
+typedef enum {
+	LOW_LEVEL, ANY_EDGE, FALLING_EDGE, RISING_EDGE
+} ExtInt_Sense;
+
+/* Structure Data Type to define External Interrupt Configurations */
+typedef struct {
+ ExtInt_Id id;
+ ExtInt_Sense sense;
+ boolean pull_up;
+} ExtInt_ConfigType;
+
+/*******************************************************************************
+ * 								 Functions Prototypes
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to setup the interrupt pin as input and enable the interrupt on the given sense
+ * An edge seen before the call is discarded
+ */
+void ExtInt_init(const ExtInt_ConfigType * Config_Ptr);
+
+/*
+ * Description:
+ * Function to set the call-back function address of the given interrupt
+ */
+void ExtInt_setCallBack(ExtInt_Id id, void(*a_ptr)(void));
+
+/*
+ * Description:
+ * Function to disable the given interrupt
+ */
+void ExtInt_deInit(ExtInt_Id id);
+
+#endif /* EXT_INT_H_ */
@@ -14,71 +14,231 @@
 #include "external_eeprom.h"
 #include "twi.h"
 
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Device address with R/W=0, we need to get A8 A9 A10 address bits from the memory location address */
+#define EEPROM_DEVICE_ADDRESS(u16addr) ((uint8)(0xA0 | (((u16addr) & 0x0700) >> 7)))
+
+/* Each device address selects a 256 bytes block, a single read is kept inside one block */
+#define EEPROM_BLOCK_SIZE 256
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Set after a write, the device ignores its address until the write cycle is finished */
+static boolean g_writeCyclePending = FALSE;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Address the device once without data, returns TRUE if it ACKs.
+ */
+static boolean EEPROM_pollDevice(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
 uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
 {
-	/* Send the Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_START)
-        return ERROR;
-
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=0 (write) */
-    TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
-    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
-        return ERROR;
-
-    /* Send the required memory location address */
-    TWI_writeByte((uint8)(u16addr));
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-
-    /* write byte to eeprom */
-    TWI_writeByte(u8data);
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-
-    /* Send the Stop Bit */
-    TWI_stop();
-
-    return SUCCESS;
+	uint8 buffer[2];
+	TWI_TransactionType transaction;
+
+	/* Only wait if the previous write cycle is still running */
+	if (EEPROM_waitReady() == ERROR)
+		return ERROR;
+
+	/* Send the required memory location address then the byte to write */
+	buffer[0] = (uint8)(u16addr);
+	buffer[1] = u8data;
+
+	transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+	transaction.write_Ptr = buffer;
+	transaction.write_size = 2;
+	transaction.read_Ptr = NULL_PTR;
+	transaction.read_size = 0;
+	transaction.callBack_Ptr = NULL_PTR;
+
+	/* The TWI interrupt runs START, SLA+W, address, data and STOP in the background */
+	if (!TWI_submitTransaction(&transaction))
+		return ERROR;
+
+	if (TWI_waitTransaction(&transaction) != TWI_TRANSACTION_DONE)
+		return ERROR;
+
+	g_writeCyclePending = TRUE;
+
+	return SUCCESS;
 }
 
 uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
 {
-	/* Send the Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_START)
-        return ERROR;
-
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=0 (write) */
-    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7)));
-    if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
-        return ERROR;
-
-    /* Send the required memory location address */
-    TWI_writeByte((uint8)(u16addr));
-    if (TWI_getStatus() != TWI_MT_DATA_ACK)
-        return ERROR;
-
-    /* Send the Repeated Start Bit */
-    TWI_start();
-    if (TWI_getStatus() != TWI_REP_START)
-        return ERROR;
-
-    /* Send the device address, we need to get A8 A9 A10 address bits from the
-     * memory location address and R/W=1 (Read) */
-    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
-    if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
-        return ERROR;
-
-    /* Read Byte from Memory without send ACK */
-    *u8data = TWI_readByteWithNACK();
-    if (TWI_getStatus() != TWI_MR_DATA_NACK)
-        return ERROR;
-
-    /* Send the Stop Bit */
-    TWI_stop();
-
-    return SUCCESS;
+	uint8 address;
+	TWI_TransactionType transaction;
+
+	/* A read only waits if it collides with a running write cycle */
+	if (EEPROM_waitReady() == ERROR)
+		return ERROR;
+
+	/* Send the required memory location address then read one byte after a repeated start */
+	address = (uint8)(u16addr);
+
+	transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+	transaction.write_Ptr = &address;
+	transaction.write_size = 1;
+	transaction.read_Ptr = u8data;
+	transaction.read_size = 1;
+	transaction.callBack_Ptr = NULL_PTR;
+
+	if (!TWI_submitTransaction(&transaction))
+		return ERROR;
+
+	if (TWI_waitTransaction(&transaction) != TWI_TRANSACTION_DONE)
+		return ERROR;
+
+	return SUCCESS;
+}
+
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data_Ptr, uint16 size)
+{
+	uint8 buffer[EEPROM_PAGE_SIZE + 1];
+	uint8 chunk_size;
+	uint8 i;
+	TWI_TransactionType transaction;
+
+	while (size != 0)
+	{
+		/* Wait for the previous page or write to be programmed */
+		if (EEPROM_waitReady() == ERROR)
+			return ERROR;
+
+		/* Write until the end of the current page at most */
+		chunk_size = EEPROM_PAGE_SIZE - (u16addr % EEPROM_PAGE_SIZE);
+		if (chunk_size > size)
+		{
+			chunk_size = size;
+		}
+
+		/* The memory location address is followed by the page data in one write phase */
+		buffer[0] = (uint8)(u16addr);
+		for (i = 0; i < chunk_size; i++)
+		{
+			buffer[i + 1] = data_Ptr[i];
+		}
+
+		transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+		transaction.write_Ptr = buffer;
+		transaction.write_size = chunk_size + 1;
+		transaction.read_Ptr = NULL_PTR;
+		transaction.read_size = 0;
+		transaction.callBack_Ptr = NULL_PTR;
+
+		if (!TWI_submitTransaction(&transaction))
+			return ERROR;
+
+		if (TWI_waitTransaction(&transaction) != TWI_TRANSACTION_DONE)
+			return ERROR;
+
+		g_writeCyclePending = TRUE;
+
+		u16addr += chunk_size;
+		data_Ptr += chunk_size;
+		size -= chunk_size;
+	}
+
+	return SUCCESS;
+}
+
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data_Ptr, uint16 size)
+{
+	uint8 address;
+	uint16 chunk_size;
+	TWI_TransactionType transaction;
+
+	/* A read only waits if it collides with a running write cycle */
+	if (EEPROM_waitReady() == ERROR)
+		return ERROR;
+
+	while (size != 0)
+	{
+		/* Read until the end of the current block at most, read_size is 8-bit */
+		chunk_size = EEPROM_BLOCK_SIZE - (u16addr % EEPROM_BLOCK_SIZE);
+		if (chunk_size > size)
+		{
+			chunk_size = size;
+		}
+		if (chunk_size > 255)
+		{
+			chunk_size = 255;
+		}
+
+		address = (uint8)(u16addr);
+
+		transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+		transaction.write_Ptr = &address;
+		transaction.write_size = 1;
+		transaction.read_Ptr = data_Ptr;
+		transaction.read_size = (uint8)chunk_size;
+		transaction.callBack_Ptr = NULL_PTR;
+
+		if (!TWI_submitTransaction(&transaction))
+			return ERROR;
+
+		if (TWI_waitTransaction(&transaction) != TWI_TRANSACTION_DONE)
+			return ERROR;
+
+		u16addr += chunk_size;
+		data_Ptr += chunk_size;
+		size -= chunk_size;
+	}
+
+	return SUCCESS;
+}
+
+boolean EEPROM_isReady(void)
+{
+	if (g_writeCyclePending && EEPROM_pollDevice())
+	{
+		g_writeCyclePending = FALSE;
+	}
+	return !g_writeCyclePending;
+}
+
+uint8 EEPROM_waitReady(void)
+{
+	uint16 polls = 0;
+
+	while (!EEPROM_isReady())
+	{
+		polls++;
+		if (polls == EEPROM_ACK_POLL_MAX)
+		{
+			return ERROR;
+		}
+	}
+	return SUCCESS;
+}
+
+static boolean EEPROM_pollDevice(void)
+{
+	TWI_TransactionType transaction;
+
+	/* The device NACKs its address while it is programming, the block bits are not needed */
+	transaction.slave_address = EEPROM_DEVICE_ADDRESS(0);
+	transaction.write_Ptr = NULL_PTR;
+	transaction.write_size = 0;
+	transaction.read_Ptr = NULL_PTR;
+	transaction.read_size = 0;
+	transaction.callBack_Ptr = NULL_PTR;
+
+	if (!TWI_submitTransaction(&transaction))
+		return FALSE;
+
+	return (TWI_waitTransaction(&transaction) == TWI_TRANSACTION_DONE);
 }
@@ -22,6 +22,15 @@
 #define ERROR 0
 #define SUCCESS 1
 
+/* 24Cxx page size, a page write can not cross a page boundary */
+#define EEPROM_PAGE_SIZE 16
+
+/*
+ * Maximum number of address polls while waiting for a write cycle to finish,
+ * a poll takes about 25us at 400KHz which covers the 10ms worst case write cycle
+ */
+#define EEPROM_ACK_POLL_MAX 1000
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -29,5 +38,33 @@
 uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
 uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
 
+/*
+ * Description:
+ * Write size bytes starting from u16addr using the page write mode,
+ * one bus transaction is used for each page touched by the block.
+ * The write cycle of the last page is still running when the function returns,
+ * the next access waits for it only if it is still running then.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data_Ptr, uint16 size);
+
+/*
+ * Description:
+ * Read size bytes starting from u16addr using the sequential read mode.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data_Ptr, uint16 size);
+
+/*
+ * Description:
+ * Return TRUE if no write cycle is running, the device is polled once if one was started.
+ */
+boolean EEPROM_isReady(void);
+
+/*
+ * Description:
+ * Wait until the running write cycle is finished by polling the device address for ACK.
+ * Returns ERROR if the device does not answer after EEPROM_ACK_POLL_MAX polls.
+ */
+uint8 EEPROM_waitReady(void);
+
 
 #endif /* EXTERNAL_EEPROM_H_ */
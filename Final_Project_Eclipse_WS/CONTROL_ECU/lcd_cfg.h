@@ -0,0 +1,66 @@
+/***************************************************************************
+ *
+ * Module Name: LCD
+ *
+ * File Name: lcd_cfg.h
+ *
+ * Description: LCD board configuration of the CONTROL ECU
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef LCD_CFG_H_
+#define LCD_CFG_H_
+
+#include "gpio.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* LCD Data bits mode configuration, its value should be 4 or 8, the benchmark builds both */
+#ifndef LCD_DATA_BITS_MODE
+#define LCD_DATA_BITS_MODE 8
+#endif
+
+/* LCD size, used by the shadow buffer */
+#define LCD_ROWS 4
+#define LCD_COLS 16
+
+/* LCD HW Ports and Pins Ids */
+#define LCD_RS_PORT_ID                 PORTD_ID
+#define LCD_RS_PIN_ID                  PIN7_ID
+
+#define LCD_E_PORT_ID                  PORTD_ID
+#define LCD_E_PIN_ID                   PIN6_ID
+
+#define LCD_DATA_PORT_ID               PORTA_ID
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+#define LCD_DB4_PIN_ID                 PIN3_ID
+#define LCD_DB5_PIN_ID                 PIN4_ID
+#define LCD_DB6_PIN_ID                 PIN5_ID
+#define LCD_DB7_PIN_ID                 PIN6_ID
+
+#endif
+
+/*
+ * LCD busy flag mode configuration, its value should be 0 or 1, the benchmark builds both
+ * 1: the R/W pin is connected and the busy flag is polled before each write, see LCD_setTimeCallBack
+ * 0: the R/W pin is tied to ground and the execution times of lcd.h are waited instead
+ */
+#ifndef LCD_BUSY_FLAG_MODE
+#define LCD_BUSY_FLAG_MODE 0
+#endif
+
+#if (LCD_BUSY_FLAG_MODE == 1)
+
+#define LCD_RW_PORT_ID                 PORTD_ID
+#define LCD_RW_PIN_ID                  PIN5_ID
+
+#endif
+
+#endif /* LCD_CFG_H_ */
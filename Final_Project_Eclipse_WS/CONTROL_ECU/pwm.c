@@ -27,7 +27,10 @@
 void PWM_Timer0_Start(uint8 duty_cycle){
 	TCNT0 = 0; /* Setting timer register initial value to 0 */
 
-	OCR0  = duty_cycle * DUTY_CYCLE_TO_COMPARE_VALUE_CONVERSION; /* Setting Compare value to duty cycle */
+	if(duty_cycle > PWM_MAX_DUTY_CYCLE){
+		duty_cycle = PWM_MAX_DUTY_CYCLE;
+	}
+	OCR0  = PWM_DUTY_TO_COMPARE(duty_cycle); /* Setting Compare value to duty cycle, integer math only */
 
 	GPIO_setupPinDirection(PORTB_ID, OC0, PIN_OUTPUT); /* Setting the direction of OC0 pin in PortB to output for PWM signal output*/
 
@@ -39,3 +42,10 @@ void PWM_Timer0_Start(uint8 duty_cycle){
 	 */
 	TCCR0 = (1<<WGM00) | (1<<WGM01) | (1<<COM01) | (1<<CS01);
 }
+
+void PWM_Timer0_setDutyCycle(uint8 duty_cycle){
+	if(duty_cycle > PWM_MAX_DUTY_CYCLE){
+		duty_cycle = PWM_MAX_DUTY_CYCLE;
+	}
+	OCR0 = PWM_DUTY_TO_COMPARE(duty_cycle); /* Double buffered in Fast PWM mode, updated at TOP */
+}
\ No newline at end of file
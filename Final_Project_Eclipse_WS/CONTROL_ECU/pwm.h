@@ -23,14 +23,32 @@
 *								Definitions
 ***************************************************************************/
 #define OC0 PB3
-#define DUTY_CYCLE_TO_COMPARE_VALUE_CONVERSION 2.55
+#define PWM_MAX_DUTY_CYCLE 100
+
+/*
+ * Compare value of a duty cycle in percent, round(duty_cycle * 255 / 100) for 0 --> 100
+ * 2.55 * duty_cycle is taken as 2 * duty_cycle + (duty_cycle * 563 + 548) / 1024 in 16-bit
+ * fixed-point, exact for every duty cycle, so there is no float or division at run time
+ * and a constant duty cycle is converted at compile time
+ */
+#define PWM_DUTY_TO_COMPARE(duty_cycle) \
+	((uint8)(2U * (duty_cycle) + (((uint16)(duty_cycle) * 563U + 548U) >> 10)))
+
 /***************************************************************************
 *								Functions Declaration
 ***************************************************************************/
 /**
  * Description:
  * Function to trigger Timer0 with PWM mode
+ * The duty cycle is in percent, values above PWM_MAX_DUTY_CYCLE give a 100% duty cycle
  */
 void PWM_Timer0_Start(uint8 duty_cycle);
 
+/**
+ * Description:
+ * Function to change the duty cycle of the running PWM signal
+ * The new compare value is taken at the end of the current period, there is no glitch
+ */
+void PWM_Timer0_setDutyCycle(uint8 duty_cycle);
+
 #endif /* PWM_H_ */
@@ -15,15 +15,52 @@
 #include "twi.h"
 #include "common_macros.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                      Definitions                                            *
+ *******************************************************************************/
+#define TWI_QUEUE_MASK (TWI_QUEUE_SIZE - 1)
+
+/* TWCR values used by the interrupt driven engine */
+#define TWI_ISR_START     ((1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE))
+#define TWI_ISR_CONTINUE  ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+#define TWI_ISR_ACK       ((1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE))
+#define TWI_ISR_STOP      ((1 << TWINT) | (1 << TWSTO) | (1 << TWEN))
+#define TWI_ISR_STOP_START ((1 << TWINT) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE))
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Queue of transactions, the head is the one on the bus */
+static TWI_TransactionType * volatile g_queue[TWI_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* Index of the next byte to write or read in the running transaction */
+static volatile uint8 g_byteIndex = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Finish the running transaction with the given status and start the next one.
+ * Called from the ISR only.
+ */
+static void TWI_finishTransaction(TWI_TransactionStatus status);
 
 void TWI_init(const TWI_ConfigType * Config_Ptr)
 {
     /*
      * Pre-scaler = 0 -> TWPS = 0
      * TWBR value is set based on the required bit-rate according to the equation:
-     * TWBR = ((CPU_Clock_Frequencey / SCL) - 16) / (2 * 4 ^ (TWPS)) */
+     * TWBR = ((CPU_Clock_Frequencey / SCL) - 16) / (2 * 4 ^ (TWPS))
+     * Integer math, a float here links the soft-float library into the image */
 	TWSR = 0x00;
-	TWBR = (uint8)(((float) F_CPU / (Config_Ptr -> bit_rate)) - 16) / 2;
+	TWBR = (uint8)(((F_CPU / (uint32)(Config_Ptr -> bit_rate)) - 16) / 2);
 
 	/* Two Wire Bus address my address if any master device want to call me: 0x1 (used in case this MC is a slave device)
     General Call Recognition: Off */
@@ -103,3 +140,146 @@ uint8 TWI_getStatus(void)
     status = TWSR & 0xF8;
     return status;
 }
+
+boolean TWI_submitTransaction(TWI_TransactionType * transaction_Ptr)
+{
+	uint8 sreg;
+	uint8 next_tail;
+
+	transaction_Ptr -> status = TWI_TRANSACTION_PENDING;
+
+	/* The queue is shared with the ISR */
+	sreg = SREG;
+	cli();
+
+	next_tail = (g_queueTail + 1) & TWI_QUEUE_MASK;
+	if (next_tail == g_queueHead)
+	{
+		SREG = sreg;
+		return FALSE;
+	}
+
+	g_queue[g_queueTail] = transaction_Ptr;
+	g_queueTail = next_tail;
+
+	/* Start the bus if it was idle, otherwise the ISR starts it after the running one */
+	if (((g_queueHead + 1) & TWI_QUEUE_MASK) == g_queueTail)
+	{
+		g_byteIndex = 0;
+		TWCR = TWI_ISR_START;
+	}
+
+	SREG = sreg;
+	return TRUE;
+}
+
+TWI_TransactionStatus TWI_waitTransaction(const TWI_TransactionType * transaction_Ptr)
+{
+	while (transaction_Ptr -> status == TWI_TRANSACTION_PENDING){}
+	return transaction_Ptr -> status;
+}
+
+boolean TWI_isBusy(void)
+{
+	return (g_queueHead != g_queueTail);
+}
+
+static void TWI_finishTransaction(TWI_TransactionStatus status)
+{
+	TWI_TransactionType * transaction_Ptr = g_queue[g_queueHead];
+
+	g_queueHead = (g_queueHead + 1) & TWI_QUEUE_MASK;
+	g_byteIndex = 0;
+
+	/* Send the stop bit, and a start bit right after it if another transaction is waiting */
+	if (g_queueHead != g_queueTail)
+	{
+		TWCR = TWI_ISR_STOP_START;
+	}
+	else
+	{
+		TWCR = TWI_ISR_STOP;
+	}
+
+	transaction_Ptr -> status = status;
+	if (transaction_Ptr -> callBack_Ptr != NULL_PTR)
+	{
+		transaction_Ptr -> callBack_Ptr(transaction_Ptr);
+	}
+}
+
+ISR(TWI_vect)
+{
+	TWI_TransactionType * transaction_Ptr = g_queue[g_queueHead];
+
+	switch (TWI_getStatus())
+	{
+	case TWI_START:
+		/* Skip the write phase of read only transactions */
+		if ((transaction_Ptr -> write_size == 0) && (transaction_Ptr -> read_size != 0))
+		{
+			TWDR = (transaction_Ptr -> slave_address) | 1;
+		}
+		else
+		{
+			TWDR = (transaction_Ptr -> slave_address) & 0XFE;
+		}
+		TWCR = TWI_ISR_CONTINUE;
+		break;
+
+	case TWI_REP_START:
+		TWDR = (transaction_Ptr -> slave_address) | 1;
+		TWCR = TWI_ISR_CONTINUE;
+		break;
+
+	case TWI_MT_SLA_W_ACK:
+	case TWI_MT_DATA_ACK:
+		if (g_byteIndex < transaction_Ptr -> write_size)
+		{
+			TWDR = transaction_Ptr -> write_Ptr[g_byteIndex];
+			g_byteIndex++;
+			TWCR = TWI_ISR_CONTINUE;
+		}
+		else if (transaction_Ptr -> read_size != 0)
+		{
+			/* Switch to the read phase */
+			TWCR = TWI_ISR_START;
+		}
+		else
+		{
+			TWI_finishTransaction(TWI_TRANSACTION_DONE);
+		}
+		break;
+
+	case TWI_MT_SLA_R_ACK:
+		g_byteIndex = 0;
+		/* ACK every byte except the last one */
+		TWCR = (transaction_Ptr -> read_size > 1) ? TWI_ISR_ACK : TWI_ISR_CONTINUE;
+		break;
+
+	case TWI_MR_DATA_ACK:
+		transaction_Ptr -> read_Ptr[g_byteIndex] = TWDR;
+		g_byteIndex++;
+		TWCR = (g_byteIndex < (transaction_Ptr -> read_size - 1)) ? TWI_ISR_ACK : TWI_ISR_CONTINUE;
+		break;
+
+	case TWI_MR_DATA_NACK:
+		transaction_Ptr -> read_Ptr[g_byteIndex] = TWDR;
+		TWI_finishTransaction(TWI_TRANSACTION_DONE);
+		break;
+
+	case TWI_MT_SLA_W_NACK:
+	case TWI_MT_SLA_R_NACK:
+		TWI_finishTransaction(TWI_TRANSACTION_ADDRESS_NACK);
+		break;
+
+	case TWI_MT_DATA_NACK:
+		TWI_finishTransaction(TWI_TRANSACTION_DATA_NACK);
+		break;
+
+	default:
+		/* Arbitration lost or bus error */
+		TWI_finishTransaction(TWI_TRANSACTION_ERROR);
+		break;
+	}
+}
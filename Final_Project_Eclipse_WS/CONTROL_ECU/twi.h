@@ -31,6 +31,19 @@
 #define TWI_MT_DATA_ACK   0x28 /* Master transmit data and ACK has been received from Slave. */
 #define TWI_MR_DATA_ACK   0x50 /* Master received data and send ACK to slave. */
 #define TWI_MR_DATA_NACK  0x58 /* Master received data but doesn't send ACK to slave. */
+#define TWI_MT_SLA_W_NACK 0x20 /* Master transmit ( slave address + Write request ) to slave + NACK received from slave. */
+#define TWI_MT_DATA_NACK  0x30 /* Master transmit data and NACK has been received from Slave. */
+#define TWI_ARB_LOST      0x38 /* Arbitration lost in slave address or data bytes. */
+#define TWI_MT_SLA_R_NACK 0x48 /* Master transmit ( slave address + Read request ) to slave + NACK received from slave. */
+
+/* Number of transactions that can wait in the queue, should be a power of two */
+#define TWI_QUEUE_SIZE    4
+
+#if((TWI_QUEUE_SIZE & (TWI_QUEUE_SIZE - 1)) != 0)
+
+#error "TWI queue size should be a power of two"
+
+#endif
 
 /*******************************************************************************
  *                      User-Defined Data Types                                    *
@@ -51,6 +64,28 @@ typedef struct{
  TWI_BaudRate bit_rate;
 } TWI_ConfigType;
 
+/* Enumeration Constants for the state of a queued transaction */
+typedef enum {
+	TWI_TRANSACTION_PENDING, TWI_TRANSACTION_DONE, TWI_TRANSACTION_ADDRESS_NACK,
+	TWI_TRANSACTION_DATA_NACK, TWI_TRANSACTION_ERROR
+} TWI_TransactionStatus;
+
+/*
+ * Structure Data Type to describe one bus transaction:
+ * START, SLA+W, write bytes, then if read_size != 0 REPEATED START, SLA+R, read bytes, STOP.
+ * A transaction without write and read bytes only checks that the device ACKs its address.
+ * The structure and its buffers must stay valid until the status is no longer pending.
+ */
+typedef struct TWI_TransactionType{
+ TWI_Adress slave_address; /* 8-bit SLA+W byte, the R/W bit is set by the driver */
+ const uint8 *write_Ptr;
+ uint8 write_size;
+ uint8 *read_Ptr;
+ uint8 read_size;
+ void (*callBack_Ptr)(struct TWI_TransactionType *transaction_Ptr); /* Called from the ISR, may be NULL_PTR */
+ volatile TWI_TransactionStatus status;
+} TWI_TransactionType;
+
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
@@ -63,5 +98,25 @@ uint8 TWI_readByteWithACK(void);
 uint8 TWI_readByteWithNACK(void);
 uint8 TWI_getStatus(void);
 
+/*
+ * Description:
+ * Queue a transaction to be run in the background by the TWI interrupt.
+ * Returns FALSE if the queue is full.
+ * The blocking functions above must not be used while transactions are in progress.
+ */
+boolean TWI_submitTransaction(TWI_TransactionType * transaction_Ptr);
+
+/*
+ * Description:
+ * Wait until the given transaction is finished and return its final status.
+ */
+TWI_TransactionStatus TWI_waitTransaction(const TWI_TransactionType * transaction_Ptr);
+
+/*
+ * Description:
+ * Return TRUE while a transaction is running or waiting in the queue.
+ */
+boolean TWI_isBusy(void);
+
 
 #endif /* TWI_H_ */
@@ -5,35 +5,32 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../HMI_Application.c \
-../gpio.c \
 ../keypad.c \
-../lcd.c \
-../timer1.c \
-../uart.c 
+../../MCAL/lcd.c 
 
 OBJS += \
 ./HMI_Application.o \
-./gpio.o \
 ./keypad.o \
-./lcd.o \
-./timer1.o \
-./uart.o 
+./lcd.o 
 
 C_DEPS += \
 ./HMI_Application.d \
-./gpio.d \
 ./keypad.d \
-./lcd.d \
-./timer1.d \
-./uart.d 
+./lcd.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ../%.c subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	avr-gcc -I".." -I"../../MCAL" -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
+lcd.o: ../../MCAL/lcd.c subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -I".." -I"../../MCAL" -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
 
@@ -18,12 +18,14 @@
 #include "gpio.h"
 #include "std_types.h"
 #include "lcd.h"
-#include <util/delay.h>
 #include "uart.h"
-#include "timer1.h"
+#include "protocol.h"
+#include "soft_timer.h"
+#include "scheduler.h"
 #include "keypad.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 /**************************************************************************
  *								 Definitions
@@ -31,10 +33,52 @@
 
 #define PASSWORD_SIZE 5
 #define PASSWORD_ENTER_KEY 13
-#define CONTROL_READY_TO_RECEIVE 0XAA
-#define HMI_READY_TO_RECEIVE 0XBB
 #define PASSWORD_CONFIRMED TRUE
 #define PASSWORD_UNCONFIRMED FALSE
+#define PASSWORD_NOT_CHECKED 2 /* The Control ECU could not read the saved password */
+#define MAX_PASSWORD_ERRORS 3
+
+/* Software timers IDs */
+#define KEYPAD_TIMER_ID 0
+#define REPLY_TIMER_ID 1
+#define MESSAGE_TIMER_ID 2
+#define LOCK_TIMER_ID 3
+#define LCD_TIMER_ID 4
+
+/* Keypad scan period, the keypad driver debounces over 3 scans */
+#define KEYPAD_SCAN_TIME_MS 10
+
+/* LCD queue period, should be longer than the LCD clear display time */
+#define LCD_QUEUE_TIME_MS 10
+
+/* Time to wait for the reply of the Control ECU, and the times the request is sent again */
+#define REPLY_TIME_MS 1000
+#define MAX_REPLY_RETRIES 2
+
+/* Messages timings */
+#define MESSAGE_TIME_MS 1000
+#define SYSTEM_LOCK_SECONDS 60
+
+/**************************************************************************
+ *								 Types Declarations
+ *************************************************************************/
+
+/* Enumeration Constants for the HMI ECU states */
+typedef enum {
+	STATE_CREATE_PASSWORD,     /* Taking the new password */
+	STATE_CONFIRM_PASSWORD,    /* Taking the new password again */
+	STATE_WAIT_CREATE_RESULT,  /* Waiting for the Control ECU to compare them */
+	STATE_MAIN_OPTIONS,
+	STATE_ENTER_PASSWORD,      /* Taking the password of the chosen option */
+	STATE_WAIT_VERIFY_RESULT,  /* Waiting for the Control ECU to check it */
+	STATE_WRONG_PASSWORD,
+	STATE_SYSTEM_LOCKED,
+	STATE_DOOR_UNLOCKING,
+	STATE_DOOR_OPEN,
+	STATE_DOOR_LOCKING,
+	STATE_PASSWORD_CHANGED,
+	STATE_NO_REPLY             /* The Control ECU did not reply after the retries */
+} HMI_State;
 
 /**************************************************************************
  *								 Global Variables
@@ -43,17 +87,57 @@
 /* Global variable to store system password */
 uint8 g_password [PASSWORD_SIZE];
 
-/*Boolean variable to confirm password */
-boolean g_passwordConfirm = PASSWORD_UNCONFIRMED;
+/* Global variable to count the entered password digits */
+uint8 g_passwordDigits = 0;
+
+/* Global variable to store the new password and its confirmation */
+uint8 g_newPassword[2 * PASSWORD_SIZE];
+
+/* Global variable to store the current state of the application */
+HMI_State g_state = STATE_CREATE_PASSWORD;
+
+/* Global variable to store the chosen option */
+uint8 g_option = '\0';
 
-/* Global variable to store interrupts count for unlocking door */
-uint8 g_unlockDoorInt;
+/* Global variable to count the wrong passwords of the current option */
+uint8 g_passwordErrorCount = 0;
 
-/* Global variable to store interrupts count for holding door */
-uint8 g_holdDoorInt;
+/* Global variables to count the requests sent again, and to store the state that waited for the reply */
+uint8 g_replyRetries = 0;
+HMI_State g_replyState;
 
-/* Global variable to store interrupts count for locking door */
-uint8 g_lockDoorInt;
+/* Global variable to store the seconds left while the system is locked */
+uint8 g_lockSeconds;
+
+/* Global variable set while a UART event is waiting in the scheduler queue */
+volatile boolean g_uartEventPending = FALSE;
+
+/* Global variable set while a keypad event is waiting in the scheduler queue */
+volatile boolean g_keypadEventPending = FALSE;
+
+/**************************************************************************
+ *								 LCD Strings
+ *************************************************************************/
+
+/* Screen texts kept in flash, they are read by the LCD _P functions and take no SRAM */
+static const char g_strPleaseEnter[] PROGMEM = "Please Enter";
+static const char g_strPleaseReenter[] PROGMEM = "Please Re-enter";
+static const char g_strPassword[] PROGMEM = "Password: ";
+static const char g_strNewPassword[] PROGMEM = "New Password: ";
+static const char g_strSystemLocked[] PROGMEM = "System is Locked";
+static const char g_strUnlockingIn[] PROGMEM = "Unlocking in ";
+static const char g_strUnlocking[] PROGMEM = "Unlocking...";
+static const char g_strDoorOpen[] PROGMEM = "Door is Open !";
+static const char g_strOpenedIn[] PROGMEM = "Opened in ";
+static const char g_strSeconds[] PROGMEM = " s";
+static const char g_strLocking[] PROGMEM = "Locking...";
+static const char g_strWrongPassword[] PROGMEM = "Wrong Password !";
+static const char g_strTryAgain[] PROGMEM = "Try Again !";
+static const char g_strNoReply[] PROGMEM = "No Reply !";
+static const char g_strOpenDoorOption[] PROGMEM = " + : Open Door ";
+static const char g_strChangePassOption[] PROGMEM = " - : Change Pass ";
+static const char g_strPasswordChanged[] PROGMEM = "Password Changed";
+static const char g_strSuccessfully[] PROGMEM = "Successfully !";
 
 /**************************************************************************
  *								Functions Prototypes
@@ -67,9 +151,16 @@ void Drivers_Init(void);
 
 /*
  * Description:
- * Function to take password from user
+ * Function to take one password digit from user
+ * Call passwordEntered when user presses Enter after 5 digits
+ */
+void getPassword(uint8 key);
+
+/*
+ * Description:
+ * Function to handle a complete password depending on the current state
  */
-void getPassword(void);
+void passwordEntered(void);
 
 /*
  * Description:
@@ -79,10 +170,34 @@ void sendPassword(void);
 
 /*
  * Description:
- * Function to create or change system password
+ * Function to send the request of the current wait state and wait for the reply of the Control ECU
+ */
+void waitReply(void);
+
+/*
+ * Description:
+ * Function to send the request of the current wait state to the Control ECU
+ */
+void sendRequest(void);
+
+/*
+ * Description:
+ * Function to send the request again when the reply timer expires, or show an error after the retries
+ */
+void replyTimeout(void);
+
+/*
+ * Description:
+ * Function to ask user to create or change system password
  */
 void createPassword (void);
 
+/*
+ * Description:
+ * Function to ask user to enter the password of the chosen option
+ */
+void enterPassword(void);
+
 /*
  * Description:
  * Function to lock the system for 1 minute
@@ -91,81 +206,121 @@ void lockSystem(void);
 
 /*
  * Description:
- * Call-back function to process interrupt by the timer for unlocking door
+ * Function to display the seconds left while the system is locked
  */
-void processUnlockDoor(void);
+void lockSystemCountdown(void);
 
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to display the unlocking message until the door is open
  */
 void unlockDoorMessage(void);
 
 /*
  * Description:
- * Call-back function to process interrupt by timer in case of holding door
+ * Function to display the open door message with the time the door took to open
  */
-void processHoldDoor(void);
+void holdDoorMessage(uint16 travel_time);
+
+/* Description:
+ * Function to display the locking message until the door is locked
+ */
+void lockDoorMessage(void);
 
 /*
  * Description:
- * Function to hold the door for 3 seconds
+ * Function to display the door state sent by the Control ECU as the door moves
  */
-void holdDoorMessage(void);
+void processDoorState(const Protocol_FrameType * frame_Ptr);
+
+/* Description:
+ * Function to handle the password confirmation status from Control ECU
+ */
+void verifyPassword(uint8 status);
 
 /*
  * Description:
- * Call-back function to process interrupt by the timer for locking door
+ * Function to display main system options
  */
-void processlockDoor(void);
+void mainOptions(void);
 
-/* Description:
- * Function to unlock door for 15 seconds
+/*
+ * Description:
+ * Function to handle a pressed key depending on the current state
  */
-void lockDoorMessage(void);
+void processKey(uint8 key);
 
-/* Description:
- * Function to verify password from user
+
+/*
+ * Description:
+ * Function to pass a received frame to the handler of the current state
  */
-void verifyPassword(void);
+void processFrame(const Protocol_FrameType * frame_Ptr);
 
 /*
  * Description:
- * Function to process data in case of user choose to open door
+ * Function to handle an expired software timer
  */
-void openDoor(void);
+void processTimer(uint8 timer_id);
 
 /*
  * Description:
- * Function to take new password from user and send to Control ECU to change system password
+ * Function to handle one event from the scheduler
  */
-void changePassword(void);
+void processEvent(const Scheduler_EventType * event_Ptr);
 
 /*
  * Description:
- * Function to display main system options
- * Take an option from user
- * Send the option to Control ECU
+ * Call-back function of the software timers, runs in the Timer1 ISR
  */
-void mainOptions(void);
+void postTimerEvent(uint8 timer_id);
 
+/*
+ * Description:
+ * Call-back function of the UART RX, runs in the UART RXC ISR
+ */
+void postUartEvent(void);
+
+/*
+ * Description:
+ * Call-back function of the keypad scanning timer, runs in the Timer1 ISR
+ */
+void scanKeypad(uint8 timer_id);
+
+/*
+ * Description:
+ * Call-back function of the keypad events, runs in the Timer1 ISR
+ */
+void postKeypadEvent(void);
+
+/*
+ * Description:
+ * Call-back function of the LCD queue timer, runs in the Timer1 ISR
+ */
+void processLcdQueue(uint8 timer_id);
 
 /**************************************************************************
  *								Main Program Execution
  *************************************************************************/
 
 int main(void){
-	sei(); /* Enabling Global Interrupt */
 	Drivers_Init(); /* Initializing all required Drivers */
+	sei(); /* Enabling Global Interrupt */
 
-	/* Asking user to create password and confirm until a confirmation occurs  */
-	while (!g_passwordConfirm){
-		createPassword();
-	}
+	/* Painting the LCD and scanning the keypad all the time in the background */
+	SoftTimer_start(LCD_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(LCD_QUEUE_TIME_MS), SOFT_TIMER_PERIODIC, processLcdQueue);
+	SoftTimer_start(KEYPAD_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(KEYPAD_SCAN_TIME_MS), SOFT_TIMER_PERIODIC, scanKeypad);
+
+	/* Asking user to create password first */
+	createPassword();
+	LCD_refresh();
+
+#ifdef SCHEDULER_POWER_STATS
+	/* The power build of the host port reads the measured time with Scheduler_reportPowerStats */
+	Scheduler_setPowerState(g_state);
+#endif
 
 	/* Program Flow */
-	while(1){
-		mainOptions(); /* Displaying and processing main options all the time */
-	}
+	Scheduler_run(processEvent);
 }
 
 /**************************************************************************
@@ -178,63 +333,105 @@ int main(void){
  */
 void Drivers_Init(void){
 	/* Variable to store UART Configurations */
-	UART_ConfigType UART_Configs = {BITS_8, NO_PARITY, BIT_1, BAUD_RATE_9600};
+	UART_ConfigType UART_Configs = {BITS_8, NO_PARITY, BIT_1, BAUD_RATE_9600, UART_INTERRUPT_MODE};
+
+	Scheduler_init();
+	UART_setRxCallBack(postUartEvent);
 	UART_init(&UART_Configs);
+	SoftTimer_init();
+	LCD_setTimeCallBack(SoftTimer_getTimeUs);
 	LCD_init();
+	KEYPAD_setEventCallBack(postKeypadEvent);
+	KEYPAD_init();
 }
 
 /*
  * Description:
- * Function to take password from user by keypad
+ * Function to take one password digit from user
+ * Call passwordEntered when user presses Enter after 5 digits
  */
-void getPassword(void){
-	uint8 temp = 0;
-	uint8 counter = 0;
+void getPassword(uint8 key){
+	/* Accepting only digits from 0 to 9 */
+	if (key <= 9 && g_passwordDigits < PASSWORD_SIZE){
+		g_password[g_passwordDigits] = key;
+		LCD_bufferDisplayCharacter('*');
+		g_passwordDigits++;
+	}
+	/* Accepting Enter only after exactly 5-digits password */
+	else if (key == PASSWORD_ENTER_KEY && g_passwordDigits == PASSWORD_SIZE){
+		g_passwordDigits = 0;
+		passwordEntered();
+	}
+}
 
-	/* Receiving exactly 5-digits password from user before user presses Enter */
-	while (temp != PASSWORD_ENTER_KEY || counter < PASSWORD_SIZE){
-		temp = KEYPAD_getPressedKey();
+/*
+ * Description:
+ * Function to handle a complete password depending on the current state
+ */
+void passwordEntered(void){
+	uint8 counter;
 
-		/* Accepting only digits from 0 to 9 */
-		if (temp <= 9 && counter < PASSWORD_SIZE){
-			g_password[counter] = temp;
-			LCD_displayCharacter('*');
-			counter++;
+	switch (g_state){
+	case STATE_CREATE_PASSWORD :
+		for (counter = 0; counter < PASSWORD_SIZE; counter++){
+			g_newPassword[counter] = g_password[counter];
 		}
 
-		_delay_ms(500);
+		LCD_bufferClear();
+		LCD_bufferMoveCursor(0,0);
+		LCD_bufferDisplayString_P(g_strPleaseReenter);
+		LCD_bufferMoveCursor(1,0);
+		LCD_bufferDisplayString_P(g_strPassword);
+		g_state = STATE_CONFIRM_PASSWORD;
+		break;
+
+	case STATE_CONFIRM_PASSWORD :
+		for (counter = 0; counter < PASSWORD_SIZE; counter++){
+			g_newPassword[PASSWORD_SIZE + counter] = g_password[counter];
+		}
+
+		/* Sending password and its confirmation to Control ECU in one frame */
+		g_state = STATE_WAIT_CREATE_RESULT;
+		waitReply();
+		break;
+
+	case STATE_ENTER_PASSWORD :
+		g_state = STATE_WAIT_VERIFY_RESULT;
+		waitReply();
+		break;
+
+	default :
+		break;
 	}
 }
 
 /*
  * Description:
- * Function to create or change system password
+ * Function to ask user to create or change system password
  */
 void createPassword (void){
-	g_passwordConfirm = PASSWORD_UNCONFIRMED;
-
-	LCD_clearScreen();
-	LCD_displayString("Please Enter");
-	LCD_moveCursor(1,0);
-	LCD_displayString("New Password: ");
-	LCD_moveCursor(2,0);
-
-	getPassword(); /* Receiving password from user */
-	sendPassword(); /* Sending password to Control ECU */
-
-	LCD_clearScreen();
-	LCD_moveCursor(0,0);
-	LCD_displayString("Please Re-enter");
-	LCD_moveCursor(1,0);
-	LCD_displayString("Password: ");
-
-	getPassword(); /* Receiving password again from user for confirmation */
-	sendPassword(); /* Sending password again to be confirmed */
-
-	/* Sending an indicator that the HMI ECU is ready to receive confirmation from Control ECU */
-	UART_sendByte(HMI_READY_TO_RECEIVE);
-	/* Receiving confirmation from Control ECU */
-	g_passwordConfirm = UART_recieveByte();
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strPleaseEnter);
+	LCD_bufferMoveCursor(1,0);
+	LCD_bufferDisplayString_P(g_strNewPassword);
+	LCD_bufferMoveCursor(2,0);
+
+	g_passwordDigits = 0;
+	g_state = STATE_CREATE_PASSWORD;
+}
+
+/*
+ * Description:
+ * Function to ask user to enter the password of the chosen option
+ */
+void enterPassword(void){
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strPleaseEnter);
+	LCD_bufferMoveCursor(1,0);
+	LCD_bufferDisplayString_P(g_strPassword);
+
+	g_passwordDigits = 0;
+	g_state = STATE_ENTER_PASSWORD;
 }
 
 /*
@@ -242,16 +439,70 @@ void createPassword (void){
  * Function to send system password to Control ECU by UART
  */
 void sendPassword(void){
-	uint8 counter;
+	/* Sending password in one frame */
+	Protocol_sendFrame(PROTOCOL_MSG_PASSWORD, g_password, PASSWORD_SIZE);
+}
+
+/*
+ * Description:
+ * Function to send the request of the current wait state and wait for the reply of the Control ECU
+ */
+void waitReply(void){
+	g_replyRetries = 0;
+	sendRequest();
+}
+
+/*
+ * Description:
+ * Function to send the request of the current wait state to the Control ECU
+ */
+void sendRequest(void){
+	switch (g_state){
+	case STATE_WAIT_CREATE_RESULT :
+		Protocol_sendFrame(PROTOCOL_MSG_NEW_PASSWORD, g_newPassword, 2 * PASSWORD_SIZE);
+		break;
+
+	case STATE_WAIT_VERIFY_RESULT :
+		/*
+		 * The option is sent again with a retry in case it was the lost frame
+		 * The Control ECU ignores it if it is already waiting for the password
+		 */
+		if (g_replyRetries != 0){
+			Protocol_sendFrame(PROTOCOL_MSG_OPTION, &g_option, PROTOCOL_OPTION_PAYLOAD_SIZE);
+		}
+		sendPassword();
+		break;
+
+	default :
+		return;
+	}
 
-	/* Waiting for Control ECU to be ready to receive data */
-	while (UART_recieveByte() != CONTROL_READY_TO_RECEIVE);
+	/* Frames with a wrong CRC or length are dropped, a lost request or reply ends with this timer */
+	SoftTimer_start(REPLY_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(REPLY_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+}
 
-	/* Sending password by UART */
-	for (counter = 0; counter < PASSWORD_SIZE; counter++){
-		UART_sendByte(g_password[counter]);
+/*
+ * Description:
+ * Function to send the request again when the reply timer expires, or show an error after the retries
+ */
+void replyTimeout(void){
+	/* The reply may have come before the timer event was handled */
+	if (g_state != STATE_WAIT_CREATE_RESULT && g_state != STATE_WAIT_VERIFY_RESULT){
+		return;
 	}
 
+	if (g_replyRetries < MAX_REPLY_RETRIES){
+		g_replyRetries++;
+		sendRequest();
+		return;
+	}
+
+	/* The password is asked again after the message */
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strNoReply);
+	SoftTimer_start(MESSAGE_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(MESSAGE_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_replyState = g_state;
+	g_state = STATE_NO_REPLY;
 }
 
 /*
@@ -259,239 +510,362 @@ void sendPassword(void){
  * Function to lock the system for 1 minute
  */
 void lockSystem(void){
-	sint8 counter;
-
-	LCD_clearScreen();
-	LCD_displayString("System is Locked");
-	LCD_moveCursor(1,0);
-	LCD_displayString("Unlocking in ");
-
-	/* Freezing the system for 60 seconds */
-	for (counter = 59; counter >= 0; counter--){
-		LCD_moveCursor(1,14);
-		LCD_intgerToString(counter);
-		if(counter < 10){
-			LCD_displayCharacter(' ');
-		}
-		_delay_ms(1000);
-	}
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strSystemLocked);
+	LCD_bufferMoveCursor(1,0);
+	LCD_bufferDisplayString_P(g_strUnlockingIn);
+
+	/* Freezing the system for 60 seconds, counting down every second */
+	g_lockSeconds = SYSTEM_LOCK_SECONDS - 1;
+	lockSystemCountdown();
+	SoftTimer_start(LOCK_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(1000), SOFT_TIMER_PERIODIC, postTimerEvent);
+	g_state = STATE_SYSTEM_LOCKED;
 }
 
-
 /*
  * Description:
- * Call-back function to process interrupt by the timer for unlocking door
+ * Function to display the seconds left while the system is locked
  */
-void processUnlockDoor(void){
-	g_unlockDoorInt++;
+void lockSystemCountdown(void){
+	LCD_bufferMoveCursor(1,14);
+	LCD_bufferIntgerToString(g_lockSeconds);
+	if(g_lockSeconds < 10){
+		LCD_bufferDisplayCharacter(' ');
+	}
 }
 
-
 /* Description:
- * Function to unlock door for 15 seconds
+ * Function to display the unlocking message until the door is open
  */
 void unlockDoorMessage(void){
-	g_unlockDoorInt = 0;
-
-	/* Configurations for Timer1 to generate an interrupt every 7.5 seconds */
-	Timer1_ConfigType Timer1_UnlockDoorConfigs = {0, 58594, F_CPU_1024, COMPARE_MODE};
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strUnlocking);
 
-	/* Sending the specified call back function to unlock door to Timer1 ISR */
-	Timer1_setCallBack(processUnlockDoor);
-
-	/* Initializing Timer1  */
-	Timer1_init(&Timer1_UnlockDoorConfigs);
-
-	LCD_clearScreen();
-	LCD_displayString("Unlocking...");
-
-	/* Wait until Timer1 counts 15 seconds*/
-	while (g_unlockDoorInt != 2){}
-
-	/* Stopping the Timer */
-	Timer1_deInit();
+	g_state = STATE_DOOR_UNLOCKING;
 }
 
 /*
  * Description:
- * Function to process interrupt by timer in case of holding door
+ * Function to display the open door message with the time the door took to open
+ */
+void holdDoorMessage(uint16 travel_time){
+	/* Travel time in tenths of a second, rounded */
+	uint16 tenths = (travel_time + 50) / 100;
+
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strDoorOpen);
+	LCD_bufferMoveCursor(1,0);
+	LCD_bufferDisplayString_P(g_strOpenedIn);
+	LCD_bufferIntgerToString(tenths / 10);
+	LCD_bufferDisplayCharacter('.');
+	LCD_bufferIntgerToString(tenths % 10);
+	LCD_bufferDisplayString_P(g_strSeconds);
+
+	g_state = STATE_DOOR_OPEN;
+}
+
+/* Description:
+ * Function to display the locking message until the door is locked
  */
-void processHoldDoor(void){
-	g_holdDoorInt++;
+void lockDoorMessage(void){
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strLocking);
+
+	g_state = STATE_DOOR_LOCKING;
 }
 
 /*
  * Description:
- * Function to hold the door for 3 seconds
+ * Function to display the door state sent by the Control ECU as the door moves
  */
-void holdDoorMessage(void){
-	g_holdDoorInt = 0;
+void processDoorState(const Protocol_FrameType * frame_Ptr){
+	uint16 travel_time;
 
-	/* Configurations for Timer1 to generate an interrupt every 3 seconds */
-	Timer1_ConfigType Timer1_HoldDoorConfigs = {0, 23438, F_CPU_1024, COMPARE_MODE};
+	/* A shorter frame would show the state or travel time left from the previous one */
+	if (frame_Ptr -> length != PROTOCOL_DOOR_STATE_PAYLOAD_SIZE){
+		return;
+	}
 
-	/* Sending the specified call back function to door door to Timer1 ISR */
-	Timer1_setCallBack(processHoldDoor);
+	/* Travel time of the last move, sent LSB first */
+	travel_time = frame_Ptr -> payload[1] | ((uint16)frame_Ptr -> payload[2] << 8);
 
-	/* Timer1 Initializing */
-	Timer1_init(&Timer1_HoldDoorConfigs);
+	switch (frame_Ptr -> payload[0]){
+	case PROTOCOL_DOOR_UNLOCKING :
+		unlockDoorMessage();
+		break;
 
-	LCD_clearScreen();
-	LCD_displayString("Door is Open !");
+	case PROTOCOL_DOOR_OPEN :
+		holdDoorMessage(travel_time);
+		break;
 
-	/* Wait until Timer1 counts 3 seconds */
-	while (g_holdDoorInt != 1){}
+	case PROTOCOL_DOOR_LOCKING :
+		lockDoorMessage();
+		break;
 
-	/* Stopping the Timer */
-	Timer1_deInit();
+	case PROTOCOL_DOOR_LOCKED :
+		mainOptions();
+		break;
+	}
 }
 
+/* Description:
+ * Function to handle the password confirmation status from Control ECU
+ */
+void verifyPassword(uint8 status){
+	if (status == PASSWORD_NOT_CHECKED){
+		/* Not a wrong password, it is asked again after the message without counting an error */
+		LCD_bufferClear();
+		LCD_bufferDisplayString_P(g_strTryAgain);
+		SoftTimer_start(MESSAGE_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(MESSAGE_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+		g_state = STATE_WRONG_PASSWORD;
+		return;
+	}
+	if (status == PASSWORD_CONFIRMED){
+		switch (g_option){
+		case '+' :
+			/* The door screens follow the door states sent by the Control ECU */
+			break;
+
+		case '-' :
+			/* Receiving new password and new password confirmation */
+			createPassword();
+			break;
+		}
+		return;
+	}
+
+	/* Displaying an error message if the password is wrong */
+	g_passwordErrorCount++;
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strWrongPassword);
+	SoftTimer_start(MESSAGE_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(MESSAGE_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+	g_state = STATE_WRONG_PASSWORD;
+}
 
 /*
  * Description:
- * Call-back function to process interrupt by the timer for locking door
+ * Function to display main system options
  */
-void processlockDoor(void){
-	g_lockDoorInt++;
-}
+void mainOptions(void){
+	LCD_bufferClear();
+	LCD_bufferDisplayString_P(g_strOpenDoorOption);
+	LCD_bufferMoveCursor(1,0);
+	LCD_bufferDisplayString_P(g_strChangePassOption);
 
+	g_option = '\0';
+	g_state = STATE_MAIN_OPTIONS;
+}
 
-/* Description:
- * Function to unlock door for 15 seconds
+/*
+ * Description:
+ * Function to handle a pressed key depending on the current state
  */
-void lockDoorMessage(void){
-	g_lockDoorInt = 0;
-
-	/* Configurations for Timer1 to generate an interrupt every 7.5 seconds */
-	Timer1_ConfigType Timer1_lockDoorConfigs = {0, 58594, F_CPU_1024, COMPARE_MODE};
-
-	/* Sending the specified call back function to lock door to Timer1 ISR */
-	Timer1_setCallBack(processlockDoor);
+void processKey(uint8 key){
+	switch (g_state){
+	case STATE_CREATE_PASSWORD :
+	case STATE_CONFIRM_PASSWORD :
+	case STATE_ENTER_PASSWORD :
+		getPassword(key);
+		break;
 
-	/* Timer1 Initializing */
-	Timer1_init(&Timer1_lockDoorConfigs);
+	case STATE_MAIN_OPTIONS :
+		/* Accepting only valid options */
+		if (key == '+' || key == '-'){
+			g_option = key;
 
-	LCD_clearScreen();
-	LCD_displayString("Locking...");
+			/* Sending Option to Control ECU */
+			Protocol_sendFrame(PROTOCOL_MSG_OPTION, &g_option, PROTOCOL_OPTION_PAYLOAD_SIZE);
 
-	/* Wait until Timer1 counts 15 seconds*/
-	while (g_lockDoorInt != 2){}
+			/* Verifying password before processing */
+			g_passwordErrorCount = 0;
+			enterPassword();
+		}
+		break;
 
-	/* Stopping the Timer */
-	Timer1_deInit();
+	default :
+		/* Keys are ignored while waiting for the Control ECU or a message */
+		break;
+	}
 }
 
-/* Description:
- * Function to verify password from user
+/*
+ * Description:
+ * Function to pass a received frame to the handler of the current state
  */
-void verifyPassword(void){
-	g_passwordConfirm = PASSWORD_UNCONFIRMED;
-	uint8 passwordErrorCount = 0;
-
-	while(!g_passwordConfirm){
+void processFrame(const Protocol_FrameType * frame_Ptr){
+	if (frame_Ptr -> type == PROTOCOL_MSG_DOOR_STATE){
+		processDoorState(frame_Ptr);
+		return;
+	}
+	if (frame_Ptr -> type != PROTOCOL_MSG_VERIFY_RESULT){
+		return;
+	}
 
-		/* Locking the system if user entered 3 unmatched password */
-		if (passwordErrorCount == 3){
-			lockSystem();
-			return;
+	switch (g_state){
+	case STATE_WAIT_CREATE_RESULT :
+		SoftTimer_stop(REPLY_TIMER_ID);
+		if (frame_Ptr -> payload[0] == PASSWORD_UNCONFIRMED){
+			/* Asking user to create password and confirm until a confirmation occurs */
+			createPassword();
 		}
+		else if (g_option == '-'){
+			LCD_bufferClear();
+			LCD_bufferDisplayString_P(g_strPasswordChanged);
+			LCD_bufferMoveCursor(1, 0);
+			LCD_bufferDisplayString_P(g_strSuccessfully);
+			SoftTimer_start(MESSAGE_TIMER_ID, SOFT_TIMER_MS_TO_TICKS(MESSAGE_TIME_MS), SOFT_TIMER_ONE_SHOT, postTimerEvent);
+			g_state = STATE_PASSWORD_CHANGED;
+		}
+		else{
+			mainOptions();
+		}
+		break;
 
-		LCD_clearScreen();
-		LCD_displayString("Please Enter");
-		LCD_moveCursor(1,0);
-		LCD_displayString("Password: ");
-
-		/* Receiving password from user to open the door */
-		getPassword();
-		sendPassword();
+	case STATE_WAIT_VERIFY_RESULT :
+		SoftTimer_stop(REPLY_TIMER_ID);
+		verifyPassword(frame_Ptr -> payload[0]);
+		break;
 
-		/* Sending an indicator that the HMI ECU is ready to receive confirmation from Control ECU */
-		UART_sendByte(HMI_READY_TO_RECEIVE);
-		/* Receiving confirmation from Control ECU */
-		g_passwordConfirm = UART_recieveByte();
-
-		/* Displaying an error message if the password is wrong */
-		if (!g_passwordConfirm){
-			passwordErrorCount++;
-			LCD_clearScreen();
-			LCD_displayString("Wrong Password !");
-			_delay_ms(1000);
-		}
+	default :
+		break;
 	}
 }
 
-
 /*
  * Description:
- * Function to process data in case of user choose to open door
+ * Function to handle an expired software timer
  */
-void openDoor(void){
+void processTimer(uint8 timer_id){
+	switch (timer_id){
+	case MESSAGE_TIMER_ID :
+		if (g_state == STATE_WRONG_PASSWORD){
+			/* Locking the system if user entered 3 unmatched password */
+			if (g_passwordErrorCount == MAX_PASSWORD_ERRORS){
+				lockSystem();
+			}
+			else{
+				enterPassword();
+			}
+		}
+		else if (g_state == STATE_PASSWORD_CHANGED){
+			mainOptions();
+		}
+		else if (g_state == STATE_NO_REPLY){
+			if (g_replyState == STATE_WAIT_CREATE_RESULT){
+				createPassword();
+			}
+			else{
+				enterPassword();
+			}
+		}
+		break;
 
-	/* Verifying password before processing */
-	verifyPassword();
+	case REPLY_TIMER_ID :
+		replyTimeout();
+		break;
 
-	if (g_passwordConfirm){
-		unlockDoorMessage();
-		holdDoorMessage();
-		lockDoorMessage();
+	case LOCK_TIMER_ID :
+		if (g_lockSeconds == 0){
+			SoftTimer_stop(LOCK_TIMER_ID);
+			mainOptions();
+		}
+		else{
+			g_lockSeconds--;
+			lockSystemCountdown();
+		}
+		break;
 	}
 }
 
 /*
  * Description:
- * Function to take new password from user and send to Control ECU to change system password
+ * Function to handle one event from the scheduler
  */
-void changePassword(void){
-
-	/* Verifying password before processing */
-	verifyPassword();
+void processEvent(const Scheduler_EventType * event_Ptr){
+	Protocol_FrameType frame;
+	KEYPAD_KeyEventType key_event;
+
+	switch (event_Ptr -> id){
+	case SCHEDULER_EVENT_UART_RX :
+		/* Bytes received after this point post a new event */
+		g_uartEventPending = FALSE;
+		while (Protocol_tryReceiveFrame(&frame)){
+			processFrame(&frame);
+		}
+		break;
 
-	/* Receiving new password and new password confirmation */
-	if (g_passwordConfirm){
-		g_passwordConfirm = PASSWORD_UNCONFIRMED;
+	case SCHEDULER_EVENT_TIMER :
+		processTimer(event_Ptr -> param);
+		break;
 
-		while (!g_passwordConfirm){
-			createPassword();
+	case SCHEDULER_EVENT_KEYPAD :
+		/* Key events queued after this point post a new event */
+		g_keypadEventPending = FALSE;
+		while (KEYPAD_getEvent(&key_event)){
+			/* A key is handled once when it is pressed, not while it is held */
+			if (key_event.event == KEYPAD_KEY_PRESSED){
+				processKey(key_event.key);
+			}
 		}
+		break;
 
-		LCD_clearScreen();
-		LCD_displayString("Password Changed");
-		LCD_moveCursor(1, 0);
-		LCD_displayString("Successfully !");
-		_delay_ms(1000);
+	default :
+		break;
 	}
+
+	/* Queueing the screen changes of this event at once, they are painted in the background */
+	LCD_refresh();
+
+#ifdef SCHEDULER_POWER_STATS
+	/* The time of this event is counted for the state it started in */
+	Scheduler_setPowerState(g_state);
+#endif
 }
 
 /*
  * Description:
- * Function to display main system options
- * Take an option from user
- * Send the option to Control ECU  */
-void mainOptions(void){
-	uint8 option = '\0';
-	LCD_clearScreen();
-	LCD_displayString(" + : Open Door ");
-	LCD_moveCursor(1,0);
-	LCD_displayString(" - : Change Pass ");
-
-	/* Taking input from Keypad until user enters a valid button*/
-	while (option != '+' && option != '-'){
-		option = KEYPAD_getPressedKey();
-		_delay_ms(500);
-	}
+ * Call-back function of the software timers, runs in the Timer1 ISR
+ */
+void postTimerEvent(uint8 timer_id){
+	Scheduler_postEvent(SCHEDULER_EVENT_TIMER, timer_id);
+}
 
-	/* Waiting for Control ECU to be ready to receive data */
-	while (UART_recieveByte() != CONTROL_READY_TO_RECEIVE);
-	/* Sending Option to Control ECU */
-	UART_sendByte(option);
+/*
+ * Description:
+ * Call-back function of the UART RX, runs in the UART RXC ISR
+ */
+void postUartEvent(void){
+	/* One event is enough for all the bytes received before it is handled */
+	if (!g_uartEventPending){
+		g_uartEventPending = Scheduler_postEvent(SCHEDULER_EVENT_UART_RX, 0);
+	}
+}
 
-	switch (option){
-	case '+' :
-		openDoor();
-		break;
+/*
+ * Description:
+ * Call-back function of the keypad scanning timer, runs in the Timer1 ISR
+ */
+void scanKeypad(uint8 timer_id){
+	(void)timer_id;
+	KEYPAD_processScan();
+}
 
-	case '-' :
-		changePassword();
-		break;
+/*
+ * Description:
+ * Call-back function of the keypad events, runs in the Timer1 ISR
+ */
+void postKeypadEvent(void){
+	/* One event is enough for all the key events queued before it is handled */
+	if (!g_keypadEventPending){
+		g_keypadEventPending = Scheduler_postEvent(SCHEDULER_EVENT_KEYPAD, 0);
 	}
 }
+
+/*
+ * Description:
+ * Call-back function of the LCD queue timer, runs in the Timer1 ISR
+ */
+void processLcdQueue(uint8 timer_id){
+	(void)timer_id;
+	LCD_processQueue();
+}
@@ -11,12 +11,96 @@
  *******************************************************************************/
 #include "keypad.h"
 #include "gpio.h"
-#include <util/delay.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define KEYPAD_NUM_KEYS          (KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS)
+#define KEYPAD_EVENT_QUEUE_MASK  (KEYPAD_EVENT_QUEUE_SIZE - 1)
+#define KEYPAD_COLS_MASK         ((1U << KEYPAD_NUM_COLS) - 1)
+
+#if (KEYPAD_NUM_ROWS != 4)
+
+#error "The keypad scan is unrolled for 4 rows"
+
+#endif
+
+/* Columns of the pressed buttons, all read at once, bit col is set if the button of this column is pressed */
+#if (KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+#define KEYPAD_READ_COLS()  ((uint8)(~GPIO_READ_PORT(KEYPAD_COL_PORT_ID) >> KEYPAD_FIRST_COL_PIN_ID) & KEYPAD_COLS_MASK)
+#else
+#define KEYPAD_READ_COLS()  ((uint8)(GPIO_READ_PORT(KEYPAD_COL_PORT_ID) >> KEYPAD_FIRST_COL_PIN_ID) & KEYPAD_COLS_MASK)
+#endif
+
+/*
+ * Drive one row as output with the pressed level, add its pressed buttons
+ * to pressed_keys then release it, the row should be a constant
+ */
+#define KEYPAD_SCAN_ROW(row,pressed_keys) \
+	do { \
+		GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+(row), PIN_OUTPUT); \
+		GPIO_WRITE_PIN(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+(row), KEYPAD_BUTTON_PRESSED); \
+		GPIO_SYNC(); \
+		(pressed_keys) |= (uint16)KEYPAD_READ_COLS() << ((row) * KEYPAD_NUM_COLS); \
+		GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+(row), PIN_INPUT); \
+	} while(0)
+
+/*******************************************************************************
+ *                                Types Declarations                          *
+ *******************************************************************************/
+
+/* Enumeration Constants for the debounce state of each key, a held key has its own release debounce */
+typedef enum {
+	KEY_RELEASED, KEY_PRESS_DEBOUNCE, KEY_PRESSED, KEY_HELD, KEY_RELEASE_DEBOUNCE, KEY_HELD_RELEASE_DEBOUNCE
+} KEYPAD_KeyState;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Debounce state machine of each key and the scans counted in its current state */
+static KEYPAD_KeyState g_keyState[KEYPAD_NUM_KEYS];
+static uint8 g_keyCount[KEYPAD_NUM_KEYS];
+
+/* Key events queue, written by KEYPAD_processScan and read by the application */
+static KEYPAD_KeyEventType g_eventQueue[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint8 g_eventHead = 0;
+static volatile uint8 g_eventTail = 0;
+
+/* Call-back function called when an event is added to the queue */
+static void (*volatile g_KEYPAD_EventCallBack)(void) = NULL_PTR;
 
 /*******************************************************************************
  *                      Functions Prototypes(Private)                          *
  *******************************************************************************/
 
+/*
+ * Description :
+ * Setup all keypad pins as input pins
+ */
+static void KEYPAD_releasePins(void);
+
+/*
+ * Description :
+ * Return the button value of the given row and column
+ */
+static uint8 KEYPAD_getKeyValue(uint8 row, uint8 col);
+
+/*
+ * Description :
+ * Scan all the keypad buttons once, all keypad pins should be input pins
+ * Bit (row * KEYPAD_NUM_COLS + col) is set if the button is pressed
+ */
+static uint16 KEYPAD_readMatrix(void);
+
+/*
+ * Description :
+ * Add a key event to the queue, the event is dropped if the queue is full
+ */
+static void KEYPAD_queueEvent(uint8 key_index, KEYPAD_EventId event);
+
 #ifndef STANDARD_KEYPAD
 
 #if (KEYPAD_NUM_COLS == 3)
@@ -39,56 +123,273 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
  *                      Functions Definitions                                  *
  *******************************************************************************/
 
+/*
+ * Description :
+ * Setup the keypad pins and clear the key states and the events queue
+ */
+void KEYPAD_init(void)
+{
+	uint8 key_index;
+
+	KEYPAD_releasePins();
+
+	for(key_index=0 ; key_index<KEYPAD_NUM_KEYS ; key_index++)
+	{
+		g_keyState[key_index] = KEY_RELEASED;
+		g_keyCount[key_index] = 0;
+	}
+	g_eventHead = 0;
+	g_eventTail = 0;
+}
+
 uint8 KEYPAD_getPressedKey(void)
 {
-	uint8 col,row;
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+1, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+2, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+3, PIN_INPUT);
-
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+1, PIN_INPUT);
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+2, PIN_INPUT);
-#if(KEYPAD_NUM_COLS == 4)
-	GPIO_setupPinDirection(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+3, PIN_INPUT);
-#endif
-	while(1)
+	uint8 key;
+
+	/* Scan the keypad again and again until a button is pressed */
+	do
+	{
+		key = KEYPAD_scanKey();
+	} while(key == KEYPAD_NO_KEY);
+
+	return key;
+}
+
+uint8 KEYPAD_scanKey(void)
+{
+	uint8 row;
+	uint8 col;
+	uint16 pressed_keys;
+
+	KEYPAD_releasePins();
+	pressed_keys = KEYPAD_readMatrix();
+
+	for(row=0 ; row<KEYPAD_NUM_ROWS ; row++)
 	{
-		for(row=0 ; row<KEYPAD_NUM_ROWS ; row++) /* loop for rows */
+		for(col=0 ; col<KEYPAD_NUM_COLS ; col++)
 		{
-			/* 
-			 * Each time setup the direction for all keypad port as input pins,
-			 * except this row will be output pin
-			 */
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_OUTPUT);
+			if(pressed_keys & (1U << ((row*KEYPAD_NUM_COLS)+col)))
+			{
+				return KEYPAD_getKeyValue(row, col);
+			}
+		}
+	}
+	return KEYPAD_NO_KEY;
+}
+
+/*
+ * Description :
+ * Scan the keypad once and advance the debounce state machine of every key
+ * Should be called periodically after KEYPAD_init, every scan is one debounce step
+ */
+void KEYPAD_processScan(void)
+{
+	uint8 key_index;
+	boolean pressed;
+	uint16 pressed_keys = KEYPAD_readMatrix();
+
+	for(key_index=0 ; key_index<KEYPAD_NUM_KEYS ; key_index++)
+	{
+		pressed = (pressed_keys & (1U << key_index)) ? TRUE : FALSE;
+
+		switch(g_keyState[key_index])
+		{
+		case KEY_RELEASED:
+			if(pressed)
+			{
+				g_keyCount[key_index] = 1;
+				g_keyState[key_index] = KEY_PRESS_DEBOUNCE;
+			}
+			break;
+
+		case KEY_PRESS_DEBOUNCE:
+			if(!pressed)
+			{
+				/* A bounce, not a press */
+				g_keyState[key_index] = KEY_RELEASED;
+			}
+			else if(++g_keyCount[key_index] >= KEYPAD_DEBOUNCE_SCANS)
+			{
+				g_keyCount[key_index] = 0;
+				g_keyState[key_index] = KEY_PRESSED;
+				KEYPAD_queueEvent(key_index, KEYPAD_KEY_PRESSED);
+			}
+			break;
+
+		case KEY_PRESSED:
+			if(!pressed)
+			{
+				g_keyCount[key_index] = 1;
+				g_keyState[key_index] = KEY_RELEASE_DEBOUNCE;
+			}
+			else if(++g_keyCount[key_index] >= KEYPAD_HOLD_SCANS)
+			{
+				g_keyState[key_index] = KEY_HELD;
+				KEYPAD_queueEvent(key_index, KEYPAD_KEY_HELD);
+			}
+			break;
 
-			/* Set/Clear the row output pin */
-			GPIO_writePin(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+row, KEYPAD_BUTTON_PRESSED);
+		case KEY_HELD:
+			if(!pressed)
+			{
+				g_keyCount[key_index] = 1;
+				g_keyState[key_index] = KEY_HELD_RELEASE_DEBOUNCE;
+			}
+			break;
 
-			for(col=0 ; col<KEYPAD_NUM_COLS ; col++) /* loop for columns */
+		case KEY_RELEASE_DEBOUNCE:
+			if(pressed)
 			{
-				/* Check if the switch is pressed in this column */
-				if(GPIO_readPin(KEYPAD_COL_PORT_ID,KEYPAD_FIRST_COL_PIN_ID+col) == KEYPAD_BUTTON_PRESSED)
-				{
-					#if (KEYPAD_NUM_COLS == 3)
-						#ifdef STANDARD_KEYPAD
-							return ((row*KEYPAD_NUM_COLS)+col+1);
-						#else
-							return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-						#endif
-					#elif (KEYPAD_NUM_COLS == 4)
-						#ifdef STANDARD_KEYPAD
-							return ((row*KEYPAD_NUM_COLS)+col+1);
-						#else
-							return KEYPAD_4x4_adjustKeyNumber((col*KEYPAD_NUM_COLS)+row+1);
-						#endif
-					#endif
-				}
+				/* A bounce, the key is still pressed */
+				g_keyCount[key_index] = 0;
+				g_keyState[key_index] = KEY_PRESSED;
 			}
-			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_INPUT);
+			else if(++g_keyCount[key_index] >= KEYPAD_DEBOUNCE_SCANS)
+			{
+				g_keyState[key_index] = KEY_RELEASED;
+				KEYPAD_queueEvent(key_index, KEYPAD_KEY_RELEASED);
+			}
+			break;
+
+		case KEY_HELD_RELEASE_DEBOUNCE:
+			if(pressed)
+			{
+				/* A bounce, the key is still held and its held event is already queued */
+				g_keyState[key_index] = KEY_HELD;
+			}
+			else if(++g_keyCount[key_index] >= KEYPAD_DEBOUNCE_SCANS)
+			{
+				g_keyState[key_index] = KEY_RELEASED;
+				KEYPAD_queueEvent(key_index, KEYPAD_KEY_RELEASED);
+			}
+			break;
 		}
-	}	
+	}
+}
+
+/*
+ * Description :
+ * Take the oldest key event from the queue
+ * Return FALSE if the queue is empty
+ */
+boolean KEYPAD_getEvent(KEYPAD_KeyEventType *event_Ptr)
+{
+	uint8 sreg;
+
+	/* The queue is written from the scanning ISR */
+	sreg = SREG;
+	cli();
+
+	if(g_eventHead == g_eventTail)
+	{
+		SREG = sreg;
+		return FALSE;
+	}
+
+	*event_Ptr = g_eventQueue[g_eventHead];
+	g_eventHead = (g_eventHead + 1) & KEYPAD_EVENT_QUEUE_MASK;
+
+	SREG = sreg;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Set the call-back function called from KEYPAD_processScan after an event is added to the queue
+ */
+void KEYPAD_setEventCallBack(void(*a_ptr)(void))
+{
+	/* Saving the address of the call back function in a global pointer to function */
+	g_KEYPAD_EventCallBack = a_ptr;
+}
+
+/*
+ * Description :
+ * Setup all keypad pins as input pins
+ */
+static void KEYPAD_releasePins(void)
+{
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID, PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+1, PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+2, PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_ROW_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID+3, PIN_INPUT);
+
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID, PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+1, PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+2, PIN_INPUT);
+#if(KEYPAD_NUM_COLS == 4)
+	GPIO_SETUP_PIN_DIRECTION(KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID+3, PIN_INPUT);
+#endif
+}
+
+/*
+ * Description :
+ * Return the button value of the given row and column
+ */
+static uint8 KEYPAD_getKeyValue(uint8 row, uint8 col)
+{
+#if (KEYPAD_NUM_COLS == 3)
+	#ifdef STANDARD_KEYPAD
+		return ((row*KEYPAD_NUM_COLS)+col+1);
+	#else
+		return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
+	#endif
+#elif (KEYPAD_NUM_COLS == 4)
+	#ifdef STANDARD_KEYPAD
+		return ((row*KEYPAD_NUM_COLS)+col+1);
+	#else
+		return KEYPAD_4x4_adjustKeyNumber((col*KEYPAD_NUM_COLS)+row+1);
+	#endif
+#endif
+}
+
+/*
+ * Description :
+ * Scan all the keypad buttons once, all keypad pins should be input pins
+ * Bit (row * KEYPAD_NUM_COLS + col) is set if the button is pressed
+ */
+static uint16 KEYPAD_readMatrix(void)
+{
+	uint16 pressed_keys = 0;
+
+	/* The rows are unrolled so every row pin is known at compile time */
+	KEYPAD_SCAN_ROW(0, pressed_keys);
+	KEYPAD_SCAN_ROW(1, pressed_keys);
+	KEYPAD_SCAN_ROW(2, pressed_keys);
+	KEYPAD_SCAN_ROW(3, pressed_keys);
+
+	return pressed_keys;
+}
+
+/*
+ * Description :
+ * Add a key event to the queue, the event is dropped if the queue is full
+ */
+static void KEYPAD_queueEvent(uint8 key_index, KEYPAD_EventId event)
+{
+	uint8 sreg;
+	uint8 next_tail;
+
+	sreg = SREG;
+	cli();
+
+	next_tail = (g_eventTail + 1) & KEYPAD_EVENT_QUEUE_MASK;
+	if(next_tail == g_eventHead)
+	{
+		SREG = sreg;
+		return;
+	}
+	g_eventQueue[g_eventTail].key = KEYPAD_getKeyValue(key_index / KEYPAD_NUM_COLS, key_index % KEYPAD_NUM_COLS);
+	g_eventQueue[g_eventTail].event = event;
+	g_eventTail = next_tail;
+
+	SREG = sreg;
+
+	if(g_KEYPAD_EventCallBack != NULL_PTR)
+	{
+		/* Notify the application that an event is waiting in the queue */
+		(*g_KEYPAD_EventCallBack)();
+	}
 }
 
 #ifndef STANDARD_KEYPAD
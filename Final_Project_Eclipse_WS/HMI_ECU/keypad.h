@@ -34,14 +34,88 @@
 #define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
 #define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
 
+/* Value returned by KEYPAD_scanKey when no button is pressed */
+#define KEYPAD_NO_KEY                    0XFF
+
+/*
+ * Debounce configurations, in calls of KEYPAD_processScan
+ * A key must read the same for KEYPAD_DEBOUNCE_SCANS scans to be pressed or released
+ * and stay pressed for KEYPAD_HOLD_SCANS scans to be held
+ */
+#define KEYPAD_DEBOUNCE_SCANS            3
+#define KEYPAD_HOLD_SCANS                100
+
+/* Number of key events that can wait in the queue, should be a power of two */
+#define KEYPAD_EVENT_QUEUE_SIZE          8
+
+#if((KEYPAD_EVENT_QUEUE_SIZE & (KEYPAD_EVENT_QUEUE_SIZE - 1)) != 0)
+
+#error "Keypad event queue size should be a power of two"
+
+#endif
+
+#if((KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS) > 16)
+
+#error "Keypad scanner supports up to 16 buttons"
+
+#endif
+
+/*******************************************************************************
+ *                                Types Declarations                          *
+ *******************************************************************************/
+
+/* Enumeration Constants for the key events */
+typedef enum {
+	KEYPAD_KEY_PRESSED, KEYPAD_KEY_RELEASED, KEYPAD_KEY_HELD
+} KEYPAD_EventId;
+
+/* Structure to hold one key event */
+typedef struct {
+ uint8 key;
+ KEYPAD_EventId event;
+} KEYPAD_KeyEventType;
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 
+/*
+ * Description :
+ * Setup the keypad pins and clear the key states and the events queue
+ */
+void KEYPAD_init(void);
+
 /*
  * Description :
  * Get the Keypad pressed button
  */
 uint8 KEYPAD_getPressedKey(void);
 
+/*
+ * Description :
+ * Scan the Keypad once without waiting
+ * Return the pressed button or KEYPAD_NO_KEY
+ */
+uint8 KEYPAD_scanKey(void);
+
+/*
+ * Description :
+ * Scan the keypad once and advance the debounce state machine of every key
+ * Should be called periodically after KEYPAD_init, every scan is one debounce step
+ */
+void KEYPAD_processScan(void);
+
+/*
+ * Description :
+ * Take the oldest key event from the queue
+ * Return FALSE if the queue is empty
+ */
+boolean KEYPAD_getEvent(KEYPAD_KeyEventType *event_Ptr);
+
+/*
+ * Description :
+ * Set the call-back function called from KEYPAD_processScan after an event is added to the queue
+ */
+void KEYPAD_setEventCallBack(void(*a_ptr)(void));
+
 #endif /* KEYPAD_H_ */
@@ -0,0 +1,216 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: control_board.c
+ *
+ * Description: Board model of the CONTROL ECU for the Linux build
+ * The DC motor direction pins and the buzzer pin are logged when they change.
+ * The door is moved by the motor at a speed following the PWM duty cycle, it
+ * drives the encoder pin (INT0) and pulls the end-stop pin (INT1) low at both
+ * ends of its travel. It starts locked, at the lower end-stop.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "host_board.h"
+#include "gpio.h"
+#include "common_macros.h"
+#include "dc_motor.h"
+#include "buzzer.h"
+#include "ext_int.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Encoder pulses between the two end-stops, and the pulses per second at 100% duty cycle */
+#define DOOR_TRAVEL_PULSES      360
+#define DOOR_FULL_SPEED_PULSES  240
+
+/*
+ * The door position is counted in encoder half pulses (one level change each)
+ * times DOOR_POSITION_SCALE, the position moves duty cycle * 2 * full speed units every us
+ */
+#define DOOR_POSITION_SCALE     100000000LL
+#define DOOR_POSITION_MAX       ((sint64)DOOR_TRAVEL_PULSES * 2 * DOOR_POSITION_SCALE)
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Level of the output pins, and the level logged last */
+static volatile uint8 g_motorPins = 0;
+static volatile uint8 g_buzzerPin = 0;
+static uint8 g_loggedMotorPins = 0;
+static uint8 g_loggedBuzzerPin = 0;
+
+/* Door position, its speed in position units per us, and the time it was moved to */
+static sint64 g_doorPosition = 0;
+static sint64 g_doorSpeed = 0;
+static uint64 g_doorUpdateUs = 0;
+static sint64 g_loggedDoorSpeed = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Log the pins that changed since the last host tick.
+ * Logging once per tick hides the short glitches, like clearing both motor pins
+ * before setting the new direction.
+ */
+static void Board_poll(void);
+
+/*
+ * Description :
+ * Move the door to the current time at its speed, then take the new speed from the
+ * motor pins and the duty cycle. The door stops at the end-stops.
+ */
+static void Door_update(void);
+
+/*
+ * Description :
+ * Ask for a poll at the next encoder level change or end-stop, for the INT0/INT1 backend.
+ */
+static void Door_requestNextEdge(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Board_init(void)
+{
+	Host_addPollFunction(Board_poll);
+}
+
+uint8 Board_readPort(uint8 port_num)
+{
+	uint8 level = 0XFF;
+
+	/* Only the door drives input pins of this ECU */
+	if (port_num == EXT_INT_PORT_ID)
+	{
+		Door_update();
+		if (((g_doorPosition / DOOR_POSITION_SCALE) & 1) == 0)
+		{
+			CLEAR_BIT(level, EXT_INT0_PIN_ID);
+		}
+		if (g_doorPosition == 0 || g_doorPosition == DOOR_POSITION_MAX)
+		{
+			CLEAR_BIT(level, EXT_INT1_PIN_ID);
+		}
+	}
+	return level;
+}
+
+void Board_portChanged(uint8 port_num)
+{
+	uint8 outputs = GPIO_getPortOutput(port_num) & GPIO_getPortDirection(port_num);
+
+	if (port_num == PORTB_ID)
+	{
+		g_motorPins = (GET_BIT(outputs, MOTOR_PIN_IN1)) | (GET_BIT(outputs, MOTOR_PIN_IN2) << 1);
+
+		/* The door moved at the old speed until now */
+		Door_update();
+		Door_requestNextEdge();
+	}
+	if (port_num == BUZZER_PORT)
+	{
+		g_buzzerPin = GET_BIT(outputs, BUZZER_PIN);
+	}
+
+	/* Logged by the next poll */
+	if (g_motorPins != g_loggedMotorPins || g_buzzerPin != g_loggedBuzzerPin)
+	{
+		Host_requestPoll(Host_getTimeUs());
+	}
+}
+
+static void Board_poll(void)
+{
+	static const char * const motor_states[] = {"STOP", "ANTI-CLOCKWISE", "CLOCKWISE", "SHORTED"};
+
+	if (g_motorPins != g_loggedMotorPins)
+	{
+		g_loggedMotorPins = g_motorPins;
+		Host_log("Motor %s", motor_states[g_loggedMotorPins]);
+	}
+	if (g_buzzerPin != g_loggedBuzzerPin)
+	{
+		g_loggedBuzzerPin = g_buzzerPin;
+		Host_log("Buzzer %s", g_loggedBuzzerPin ? "ON" : "OFF");
+	}
+
+	Door_update();
+	if (g_doorSpeed != g_loggedDoorSpeed)
+	{
+		g_loggedDoorSpeed = g_doorSpeed;
+		if (g_doorSpeed == 0)
+		{
+			Host_log("Door stopped at %lld pulses", (long long)(g_doorPosition / DOOR_POSITION_SCALE / 2));
+		}
+	}
+	Door_requestNextEdge();
+}
+
+static void Door_update(void)
+{
+	uint64 now = Host_getTimeUs();
+
+	g_doorPosition += g_doorSpeed * (sint64)(now - g_doorUpdateUs);
+	g_doorUpdateUs = now;
+	if (g_doorPosition <= 0)
+	{
+		g_doorPosition = 0;
+	}
+	if (g_doorPosition >= DOOR_POSITION_MAX)
+	{
+		g_doorPosition = DOOR_POSITION_MAX;
+	}
+
+	/* CLOCKWISE opens the door, a shorted motor brakes */
+	g_doorSpeed = (sint64)PWM_getDutyCycle() * 2 * DOOR_FULL_SPEED_PULSES;
+	if (g_motorPins == CW)
+	{
+		/* Moving up */
+	}
+	else if (g_motorPins == A_CW)
+	{
+		g_doorSpeed = -g_doorSpeed;
+	}
+	else
+	{
+		g_doorSpeed = 0;
+	}
+
+	/* Pushing into an end-stop does not move the door */
+	if ((g_doorPosition == 0 && g_doorSpeed < 0) || (g_doorPosition == DOOR_POSITION_MAX && g_doorSpeed > 0))
+	{
+		g_doorSpeed = 0;
+	}
+}
+
+static void Door_requestNextEdge(void)
+{
+	sint64 next_position;
+
+	if (g_doorSpeed > 0)
+	{
+		next_position = (g_doorPosition / DOOR_POSITION_SCALE + 1) * DOOR_POSITION_SCALE;
+		Host_requestPoll(g_doorUpdateUs + (next_position - g_doorPosition + g_doorSpeed - 1) / g_doorSpeed);
+	}
+	else if (g_doorSpeed < 0)
+	{
+		next_position = (g_doorPosition / DOOR_POSITION_SCALE) * DOOR_POSITION_SCALE - 1;
+		Host_requestPoll(g_doorUpdateUs + (g_doorPosition - next_position - g_doorSpeed - 1) / -g_doorSpeed);
+	}
+}
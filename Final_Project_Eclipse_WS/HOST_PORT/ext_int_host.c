@@ -0,0 +1,110 @@
+/***************************************************************************
+ *
+ * Module Name: External Interrupts
+ *
+ * File Name: ext_int_host.c
+ *
+ * Description: Source file for the Linux backend of the External Interrupts Driver
+ * The interrupt pins are read from the board model on every host poll, the board
+ * model requests a poll for every level change it makes.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "ext_int.h"
+#include "host_board.h"
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+#define EXT_INT_NUM 2
+
+/*******************************************************************************
+ * 								 Global Variables
+ *******************************************************************************/
+static void (*volatile g_callBacks[EXT_INT_NUM]) (void) = {NULL_PTR, NULL_PTR};
+
+static const uint8 g_pins[EXT_INT_NUM] = {EXT_INT0_PIN_ID, EXT_INT1_PIN_ID};
+
+/* Sense of the enabled interrupts and the pin level seen by the last poll */
+static ExtInt_Sense g_sense[EXT_INT_NUM];
+static boolean g_enabled[EXT_INT_NUM] = {FALSE, FALSE};
+static uint8 g_lastLevel[EXT_INT_NUM];
+
+static boolean g_pollRegistered = FALSE;
+
+/*******************************************************************************
+ * 								 Functions Prototypes(Private)
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Host interrupt poll function, calls the call-back function of every pin that changed as sensed
+ */
+static void ExtInt_poll(void);
+
+/*******************************************************************************
+ * 								 Functions Definitions
+ *******************************************************************************/
+void ExtInt_init(const ExtInt_ConfigType * Config_Ptr){
+	uint8 id = Config_Ptr -> id;
+
+	if (!g_pollRegistered){
+		Host_addPollFunction(ExtInt_poll);
+		g_pollRegistered = TRUE;
+	}
+
+	GPIO_setupPinDirection(EXT_INT_PORT_ID, g_pins[id], PIN_INPUT);
+	GPIO_writePin(EXT_INT_PORT_ID, g_pins[id], Config_Ptr -> pull_up ? LOGIC_HIGH : LOGIC_LOW);
+
+	g_sense[id] = Config_Ptr -> sense;
+	g_lastLevel[id] = GPIO_readPin(EXT_INT_PORT_ID, g_pins[id]);
+	g_enabled[id] = TRUE;
+}
+
+void ExtInt_setCallBack(ExtInt_Id id, void(*a_ptr)(void)){
+	g_callBacks[id] = a_ptr;
+}
+
+void ExtInt_deInit(ExtInt_Id id){
+	g_enabled[id] = FALSE;
+}
+
+static void ExtInt_poll(void){
+	uint8 id;
+	uint8 level;
+	boolean interrupt;
+
+	for (id = 0; id < EXT_INT_NUM; id++){
+		if (!g_enabled[id]){
+			continue;
+		}
+
+		level = GPIO_readPin(EXT_INT_PORT_ID, g_pins[id]);
+		switch (g_sense[id]){
+		case LOW_LEVEL :
+			interrupt = (level == LOGIC_LOW);
+			break;
+		case ANY_EDGE :
+			interrupt = (level != g_lastLevel[id]);
+			break;
+		case FALLING_EDGE :
+			interrupt = (level == LOGIC_LOW && g_lastLevel[id] == LOGIC_HIGH);
+			break;
+		default :
+			interrupt = (level == LOGIC_HIGH && g_lastLevel[id] == LOGIC_LOW);
+			break;
+		}
+		g_lastLevel[id] = level;
+
+		if (interrupt && g_callBacks[id] != NULL_PTR){
+			(*g_callBacks[id])();
+		}
+	}
+}
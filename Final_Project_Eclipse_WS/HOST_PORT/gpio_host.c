@@ -0,0 +1,174 @@
+ /******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio_host.c
+ *
+ * Description: Source file for the Linux backend of the GPIO driver
+ * The port registers are kept in memory and the pins are wired to the board model.
+ *
+ * Author: Omar EL-Sheikh
+ *
+ *******************************************************************************/
+
+#include "gpio.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include "host_board.h"
+
+/* Emulated PORTx and DDRx registers */
+static uint8 g_portOutput[NUM_OF_PORTS];
+static uint8 g_portDirection[NUM_OF_PORTS];
+
+/*
+ * Description :
+ * Setup the direction of the required pin input/output.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ */
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+	if((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		if(direction == PIN_OUTPUT)
+		{
+			SET_BIT(g_portDirection[port_num],pin_num);
+		}
+		else
+		{
+			CLEAR_BIT(g_portDirection[port_num],pin_num);
+		}
+		Board_portChanged(port_num);
+	}
+}
+
+/*
+ * Description :
+ * Write the value Logic High or Logic Low on the required pin.
+ * If the input port number or pin number are not correct, The function will not handle the request.
+ * If the pin is input, this function will enable/disable the internal pull-up resistor.
+ */
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+	if((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		if(value == LOGIC_HIGH)
+		{
+			SET_BIT(g_portOutput[port_num],pin_num);
+		}
+		else
+		{
+			CLEAR_BIT(g_portOutput[port_num],pin_num);
+		}
+		Board_portChanged(port_num);
+	}
+}
+
+/*
+ * Description :
+ * Read and return the value for the required pin, it should be Logic High or Logic Low.
+ * If the input port number or pin number are not correct, The function will return Logic Low.
+ */
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num)
+{
+	if((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+	{
+		return LOGIC_LOW;
+	}
+	return BIT_IS_SET(GPIO_readPort(port_num),pin_num) ? LOGIC_HIGH : LOGIC_LOW;
+}
+
+/*
+ * Description :
+ * Setup the direction of the required port all pins input/output.
+ * If the direction value is PORT_INPUT all pins in this port should be input pins.
+ * If the direction value is PORT_OUTPUT all pins in this port should be output pins.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_setupPortDirection(uint8 port_num, GPIO_PortDirectionType direction)
+{
+	if(port_num >= NUM_OF_PORTS)
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		g_portDirection[port_num] = direction;
+		Board_portChanged(port_num);
+	}
+}
+
+/*
+ * Description :
+ * Write the value on the required port.
+ * If any pin in the port is output pin the value will be written.
+ * If any pin in the port is input pin this will activate/deactivate the internal pull-up resistor.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePort(uint8 port_num, uint8 value)
+{
+	if(port_num >= NUM_OF_PORTS)
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		g_portOutput[port_num] = value;
+		Board_portChanged(port_num);
+	}
+}
+
+/*
+ * Description :
+ * Write the bits of the value selected by the mask on the required port, the other pins keep their value.
+ * All the selected pins change together in one register write.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num, uint8 mask, uint8 value)
+{
+	if(port_num >= NUM_OF_PORTS)
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		g_portOutput[port_num] = (g_portOutput[port_num] & ~mask) | (value & mask);
+		Board_portChanged(port_num);
+	}
+}
+
+/*
+ * Description :
+ * Read and return the value of the required port.
+ * Output pins read back their PORTx bit, input pins read the level driven by the board.
+ * If the input port number is not correct, The function will return ZERO value.
+ */
+uint8 GPIO_readPort(uint8 port_num)
+{
+	if(port_num >= NUM_OF_PORTS)
+	{
+		return 0;
+	}
+	return (g_portOutput[port_num] & g_portDirection[port_num])
+			| (Board_readPort(port_num) & ~g_portDirection[port_num]);
+}
+
+/*
+ * Description :
+ * Return the output and direction registers of a port, for the board models.
+ */
+uint8 GPIO_getPortOutput(uint8 port_num)
+{
+	return g_portOutput[port_num];
+}
+
+uint8 GPIO_getPortDirection(uint8 port_num)
+{
+	return g_portDirection[port_num];
+}
@@ -0,0 +1,360 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: hmi_board.c
+ *
+ * Description: Board model of the HMI ECU for the Linux build
+ *
+ * LCD:    an HD44780 model latches the writes on the falling edge of E
+ *         and prints the screen when it stays unchanged for LCD_MODEL_SETTLE_US.
+ * Keypad: the typed keys (Host_readKey) are pressed one at a time on the 4x4 matrix,
+ *         0-9 + - * % = are the keypad keys, Enter is the enter key (13)
+ *         and a space waits KEYPAD_MODEL_PAUSE_US, so scripts can be piped in.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "host_board.h"
+#include "gpio.h"
+#include "common_macros.h"
+#include "lcd.h"
+#include "keypad.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define LCD_MODEL_DDRAM_SIZE      128
+#define LCD_MODEL_SETTLE_US       20000
+
+#define KEYPAD_MODEL_HOLD_US      100000
+#define KEYPAD_MODEL_GAP_US       100000
+#define KEYPAD_MODEL_PAUSE_US     1000000
+#define KEYPAD_MODEL_QUEUE_SIZE   64
+#define KEYPAD_MODEL_NO_BUTTON    0XFF
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* HD44780 state */
+static uint8 g_ddram[LCD_MODEL_DDRAM_SIZE];
+static uint8 g_addressCounter = 0;
+static boolean g_fourBitsInterface = FALSE;
+static boolean g_highNibbleLatched = FALSE;
+static uint8 g_highNibble = 0;
+static uint8 g_lastE = LOGIC_LOW;
+static boolean g_lcdChanged = FALSE;
+static uint64 g_lcdChangeTimeUs = 0;
+
+/* Keys typed on stdin waiting to be pressed */
+static uint8 g_typedKeys[KEYPAD_MODEL_QUEUE_SIZE];
+static uint8 g_typedHead = 0;
+static uint8 g_typedTail = 0;
+
+/* Button held on the matrix, as a row and a column */
+static volatile uint8 g_pressedRow = KEYPAD_MODEL_NO_BUTTON;
+static volatile uint8 g_pressedCol = KEYPAD_MODEL_NO_BUTTON;
+static uint64 g_keyStepEndUs = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Execute one instruction or data write on the LCD model.
+ */
+static void LCD_modelWrite(uint8 rs, uint8 value);
+
+/*
+ * Description :
+ * Latch the LCD pins on the falling edge of E.
+ */
+static void LCD_modelLatch(void);
+
+/*
+ * Description :
+ * Print the LCD rows.
+ */
+static void LCD_modelPrint(void);
+
+/*
+ * Description :
+ * Find the matrix position of a typed key, returns FALSE for other characters.
+ */
+static boolean KEYPAD_modelFindButton(uint8 typed, uint8 *row_Ptr, uint8 *col_Ptr);
+
+/*
+ * Description :
+ * Take the typed keys and press or release them on time.
+ */
+static void KEYPAD_modelPoll(void);
+
+/*
+ * Description :
+ * Host interrupt poll function of the board.
+ */
+static void Board_poll(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Board_init(void)
+{
+	memset(g_ddram, ' ', sizeof(g_ddram));
+	Host_keysInit();
+	Host_addPollFunction(Board_poll);
+}
+
+uint8 Board_readPort(uint8 port_num)
+{
+	uint8 levels = 0XFF;
+	uint8 row_pin;
+
+#if (LCD_BUSY_FLAG_MODE == 1)
+	/* The LCD drives its data pins while R/W is high, it is never busy */
+	if (port_num == LCD_DATA_PORT_ID &&
+			BIT_IS_SET(GPIO_getPortOutput(LCD_RW_PORT_ID) & GPIO_getPortDirection(LCD_RW_PORT_ID), LCD_RW_PIN_ID))
+	{
+		levels = 0X00;
+	}
+#endif
+
+	/* The pressed button connects its row pin to its column pin */
+	if (port_num == KEYPAD_COL_PORT_ID && g_pressedRow != KEYPAD_MODEL_NO_BUTTON)
+	{
+		row_pin = KEYPAD_FIRST_ROW_PIN_ID + g_pressedRow;
+		if (BIT_IS_SET(GPIO_getPortDirection(KEYPAD_ROW_PORT_ID), row_pin) &&
+				BIT_IS_CLEAR(GPIO_getPortOutput(KEYPAD_ROW_PORT_ID), row_pin))
+		{
+			CLEAR_BIT(levels, (KEYPAD_FIRST_COL_PIN_ID + g_pressedCol));
+		}
+	}
+
+	return levels;
+}
+
+void Board_portChanged(uint8 port_num)
+{
+	uint8 e_level;
+
+	if (port_num != LCD_E_PORT_ID)
+	{
+		return;
+	}
+
+	e_level = GET_BIT(GPIO_getPortOutput(LCD_E_PORT_ID), LCD_E_PIN_ID);
+	if (g_lastE == LOGIC_HIGH && e_level == LOGIC_LOW)
+	{
+		LCD_modelLatch();
+	}
+	g_lastE = e_level;
+}
+
+static void LCD_modelLatch(void)
+{
+	uint8 rs = GET_BIT(GPIO_getPortOutput(LCD_RS_PORT_ID), LCD_RS_PIN_ID);
+	uint8 pins = GPIO_getPortOutput(LCD_DATA_PORT_ID);
+	uint8 data;
+
+#if (LCD_BUSY_FLAG_MODE == 1)
+	/* A read of the busy flag, nothing to latch */
+	if (BIT_IS_SET(GPIO_getPortOutput(LCD_RW_PORT_ID), LCD_RW_PIN_ID))
+	{
+		return;
+	}
+#endif
+
+#if (LCD_DATA_BITS_MODE == 4)
+	/* DB0-DB3 are not connected, they read as zero in the 8-bits interface */
+	data = (GET_BIT(pins, LCD_DB4_PIN_ID) << 4) | (GET_BIT(pins, LCD_DB5_PIN_ID) << 5)
+			| (GET_BIT(pins, LCD_DB6_PIN_ID) << 6) | (GET_BIT(pins, LCD_DB7_PIN_ID) << 7);
+#else
+	data = pins;
+#endif
+
+	if (!g_fourBitsInterface)
+	{
+		LCD_modelWrite(rs, data);
+	}
+	else if (!g_highNibbleLatched)
+	{
+		g_highNibble = data & 0XF0;
+		g_highNibbleLatched = TRUE;
+	}
+	else
+	{
+		g_highNibbleLatched = FALSE;
+		LCD_modelWrite(rs, g_highNibble | (data >> 4));
+	}
+}
+
+static void LCD_modelWrite(uint8 rs, uint8 value)
+{
+	if (rs == LOGIC_HIGH)
+	{
+		g_ddram[g_addressCounter] = value;
+		g_addressCounter = (g_addressCounter + 1) & (LCD_MODEL_DDRAM_SIZE - 1);
+	}
+	else if (value & 0X80)
+	{
+		/* Set DDRAM address */
+		g_addressCounter = value & 0X7F;
+		return;
+	}
+	else if (value & 0X20)
+	{
+		/* Function set, DL bit selects the interface */
+		g_fourBitsInterface = (value & 0X10) ? FALSE : TRUE;
+		g_highNibbleLatched = FALSE;
+		return;
+	}
+	else if (value == LCD_CLEAR_COMMAND)
+	{
+		memset(g_ddram, ' ', sizeof(g_ddram));
+		g_addressCounter = 0;
+	}
+	else if ((value & 0XFE) == LCD_GO_TO_HOME)
+	{
+		g_addressCounter = 0;
+		return;
+	}
+	else
+	{
+		/* Display and entry mode settings, the model always shows the text */
+		return;
+	}
+
+	g_lcdChanged = TRUE;
+	g_lcdChangeTimeUs = Host_getTimeUs();
+	Host_requestPoll(g_lcdChangeTimeUs + LCD_MODEL_SETTLE_US);
+}
+
+static void LCD_modelPrint(void)
+{
+	static const uint8 row_addresses[] = {0X00, 0X40, 0X10, 0X50};
+	char line[LCD_COLS + 1];
+	uint8 row;
+	uint8 col;
+
+	Host_log("+----------------+");
+	for (row = 0; row < LCD_ROWS; row++)
+	{
+		for (col = 0; col < LCD_COLS; col++)
+		{
+			line[col] = (g_ddram[row_addresses[row] + col] >= ' ' && g_ddram[row_addresses[row] + col] < 0X7F)
+					? g_ddram[row_addresses[row] + col] : '?';
+		}
+		line[LCD_COLS] = '\0';
+		Host_log("|%s|", line);
+	}
+	Host_log("+----------------+");
+}
+
+static boolean KEYPAD_modelFindButton(uint8 typed, uint8 *row_Ptr, uint8 *col_Ptr)
+{
+	/* Values of the buttons 1 to 16, button number = (col * 4) + row + 1 */
+	static const uint8 button_values[] = {7, 8, 9, '%', 4, 5, 6, '*', 1, 2, 3, '-', 13, 0, '=', '+'};
+	uint8 value;
+	uint8 button;
+
+	if (typed >= '0' && typed <= '9')
+	{
+		value = typed - '0';
+	}
+	else if (typed == '\n' || typed == '\r')
+	{
+		value = 13;
+	}
+	else
+	{
+		value = typed;
+	}
+
+	for (button = 0; button < sizeof(button_values); button++)
+	{
+		if (button_values[button] == value)
+		{
+			*col_Ptr = button / KEYPAD_NUM_COLS;
+			*row_Ptr = button % KEYPAD_NUM_COLS;
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+static void KEYPAD_modelPoll(void)
+{
+	uint8 typed;
+	uint8 row;
+	uint8 col;
+	uint64 now = Host_getTimeUs();
+
+	while (((g_typedHead + 1) % KEYPAD_MODEL_QUEUE_SIZE) != g_typedTail && Host_readKey(&typed))
+	{
+		g_typedKeys[g_typedHead] = typed;
+		g_typedHead = (g_typedHead + 1) % KEYPAD_MODEL_QUEUE_SIZE;
+	}
+
+	if (now < g_keyStepEndUs)
+	{
+		Host_requestPoll(g_keyStepEndUs);
+		return;
+	}
+
+	if (g_pressedRow != KEYPAD_MODEL_NO_BUTTON)
+	{
+		g_pressedRow = KEYPAD_MODEL_NO_BUTTON;
+		g_keyStepEndUs = now + KEYPAD_MODEL_GAP_US;
+		Host_requestPoll(g_keyStepEndUs);
+		return;
+	}
+
+	while (g_typedTail != g_typedHead)
+	{
+		typed = g_typedKeys[g_typedTail];
+		g_typedTail = (g_typedTail + 1) % KEYPAD_MODEL_QUEUE_SIZE;
+
+		if (typed == ' ')
+		{
+			g_keyStepEndUs = now + KEYPAD_MODEL_PAUSE_US;
+			Host_requestPoll(g_keyStepEndUs);
+			return;
+		}
+		if (KEYPAD_modelFindButton(typed, &row, &col))
+		{
+			g_pressedCol = col;
+			g_pressedRow = row;
+			g_keyStepEndUs = now + KEYPAD_MODEL_HOLD_US;
+			Host_requestPoll(g_keyStepEndUs);
+			return;
+		}
+	}
+}
+
+static void Board_poll(void)
+{
+	KEYPAD_modelPoll();
+
+	if (g_lcdChanged)
+	{
+		if ((Host_getTimeUs() - g_lcdChangeTimeUs) >= LCD_MODEL_SETTLE_US)
+		{
+			g_lcdChanged = FALSE;
+			LCD_modelPrint();
+		}
+		else
+		{
+			Host_requestPoll(g_lcdChangeTimeUs + LCD_MODEL_SETTLE_US);
+		}
+	}
+}
@@ -0,0 +1,355 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: host_board.c
+ *
+ * Description: Source file for the Linux board of the ECUs host build
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#define _GNU_SOURCE
+#include "host_board.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Emulated status register, the I-bit is set by sei() in the application */
+volatile unsigned char Host_sreg = 0;
+
+/* Poll functions, called from the SIGALRM handler in place of the ISRs */
+static void (*g_pollFunctions[HOST_MAX_POLL_FUNCTIONS])(void);
+static volatile uint8 g_pollCount = 0;
+
+/* Set when a SIGALRM came while the I-bit was clear */
+static volatile sig_atomic_t g_pollPending = 0;
+
+/* Real start time and the virtual clock speed */
+static struct timespec g_startTime;
+static uint64 g_speed = 1;
+
+/* UART link descriptor, -1 when not connected */
+static int g_linkFd = -1;
+
+/* Keypad input from stdin */
+static boolean g_keysOpened = FALSE;
+static struct termios g_savedTerminal;
+static boolean g_terminalChanged = FALSE;
+static int g_savedStdinFlags = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Call the poll functions with the I-bit cleared, like an ISR.
+ */
+static void Host_runPollFunctions(void);
+
+/*
+ * Description :
+ * SIGALRM handler, the host interrupt.
+ */
+static void Host_tickHandler(int signal_num);
+
+/*
+ * Description :
+ * Restore the terminal settings and the stdin flags at exit.
+ */
+static void Host_restoreTerminal(void);
+static void Host_signalExit(int signal_num);
+
+/*
+ * Description :
+ * Start the virtual clock, the board model and the host interrupt before main().
+ */
+static void Host_init(void) __attribute__((constructor));
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Host_addPollFunction(void(*a_ptr)(void))
+{
+	if (g_pollCount < HOST_MAX_POLL_FUNCTIONS)
+	{
+		g_pollFunctions[g_pollCount] = a_ptr;
+		g_pollCount++;
+	}
+}
+
+void Host_requestPoll(uint64 time_us)
+{
+	/* The poll functions are called every tick anyway */
+	(void)time_us;
+}
+
+uint64 Host_getTimeUs(void)
+{
+	struct timespec now;
+	uint64 real_us;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	real_us = (uint64)(now.tv_sec - g_startTime.tv_sec) * 1000000ULL
+			+ (uint64)((now.tv_nsec - g_startTime.tv_nsec) / 1000L);
+
+	return real_us * g_speed;
+}
+
+void Host_delayUs(unsigned long us)
+{
+	uint64 end_time = Host_getTimeUs() + us;
+	uint64 now;
+	uint64 real_us;
+	struct timespec wait_time;
+
+	while ((now = Host_getTimeUs()) < end_time)
+	{
+		real_us = (end_time - now + g_speed - 1) / g_speed;
+		wait_time.tv_sec = real_us / 1000000ULL;
+		wait_time.tv_nsec = (real_us % 1000000ULL) * 1000L;
+		nanosleep(&wait_time, NULL);
+	}
+}
+
+void Host_log(const char *format, ...)
+{
+	char line[160];
+	int length;
+	uint64 now = Host_getTimeUs();
+	va_list args;
+
+	length = snprintf(line, sizeof(line), "[%5lu.%03lu %s] ",
+			(unsigned long)(now / 1000000ULL), (unsigned long)((now / 1000ULL) % 1000ULL), HOST_ECU_NAME);
+
+	va_start(args, format);
+	length += vsnprintf(line + length, sizeof(line) - length, format, args);
+	va_end(args);
+
+	if (length > (int)sizeof(line) - 2)
+	{
+		length = sizeof(line) - 2;
+	}
+	line[length++] = '\n';
+
+	/* write() is safe in the signal handler, stdio buffers are not */
+	if (write(STDOUT_FILENO, line, length) < 0){}
+}
+
+/*
+ * Description :
+ * The link is an inherited descriptor (HOST_UART_FD), like one end of the
+ * socketpair made by the launcher, or a path to open (HOST_UART_PATH),
+ * like a pty or a serial port, which is set to raw mode.
+ */
+void Host_linkInit(void)
+{
+	const char *fd_name = getenv("HOST_UART_FD");
+	const char *path = getenv("HOST_UART_PATH");
+	struct termios settings;
+
+	if (g_linkFd >= 0)
+	{
+		return;
+	}
+
+	if (fd_name != NULL)
+	{
+		g_linkFd = atoi(fd_name);
+	}
+	else if (path != NULL)
+	{
+		g_linkFd = open(path, O_RDWR | O_NOCTTY);
+		if (g_linkFd >= 0 && tcgetattr(g_linkFd, &settings) == 0)
+		{
+			cfmakeraw(&settings);
+			tcsetattr(g_linkFd, TCSANOW, &settings);
+		}
+	}
+
+	if (g_linkFd < 0)
+	{
+		Host_log("UART is not connected, set HOST_UART_FD or HOST_UART_PATH");
+		return;
+	}
+
+	/* Reads are done from the host interrupt, which must never block */
+	fcntl(g_linkFd, F_SETFL, fcntl(g_linkFd, F_GETFL) | O_NONBLOCK);
+}
+
+void Host_linkWrite(const uint8 *data_Ptr, uint8 size)
+{
+	uint8 count = 0;
+	ssize_t written;
+
+	while (g_linkFd >= 0 && count < size)
+	{
+		written = write(g_linkFd, data_Ptr + count, size - count);
+		if (written > 0)
+		{
+			count += written;
+		}
+		else if (written < 0 && errno != EAGAIN && errno != EINTR)
+		{
+			/* The other ECU is gone, drop the bytes like a disconnected wire */
+			break;
+		}
+	}
+}
+
+boolean Host_linkRead(uint8 *data_Ptr)
+{
+	return (g_linkFd >= 0 && read(g_linkFd, data_Ptr, 1) == 1);
+}
+
+/*
+ * Description :
+ * The keys come from stdin, one by one and without echo on a terminal.
+ */
+void Host_keysInit(void)
+{
+	struct termios settings;
+
+	/* Ctrl+C still ends the process */
+	if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &g_savedTerminal) == 0)
+	{
+		settings = g_savedTerminal;
+		settings.c_lflag &= ~(ICANON | ECHO);
+		settings.c_cc[VMIN] = 0;
+		settings.c_cc[VTIME] = 0;
+		tcsetattr(STDIN_FILENO, TCSANOW, &settings);
+		g_terminalChanged = TRUE;
+	}
+
+	/* The shell shares the stdin file, it gets it back blocking */
+	g_savedStdinFlags = fcntl(STDIN_FILENO, F_GETFL);
+	fcntl(STDIN_FILENO, F_SETFL, g_savedStdinFlags | O_NONBLOCK);
+	g_keysOpened = TRUE;
+
+	atexit(Host_restoreTerminal);
+	signal(SIGINT, Host_signalExit);
+	signal(SIGTERM, Host_signalExit);
+}
+
+boolean Host_readKey(uint8 *key_Ptr)
+{
+	return (g_keysOpened && read(STDIN_FILENO, key_Ptr, 1) == 1);
+}
+
+void Host_enableInterrupts(void)
+{
+	Host_sreg |= (1 << SREG_I);
+
+	/* Interrupts that came while the I-bit was clear are served now */
+	if (g_pollPending)
+	{
+		Host_runPollFunctions();
+	}
+}
+
+void Host_disableInterrupts(void)
+{
+	Host_sreg &= ~(1 << SREG_I);
+}
+
+void Host_sleep(void)
+{
+	/* Any signal wakes up the process, the next SIGALRM comes within a tick */
+	pause();
+}
+
+static void Host_runPollFunctions(void)
+{
+	uint8 i;
+
+	/* The I-bit is cleared while the ISRs run */
+	Host_sreg &= ~(1 << SREG_I);
+	g_pollPending = 0;
+
+	for (i = 0; i < g_pollCount; i++)
+	{
+		(*g_pollFunctions[i])();
+	}
+
+	Host_sreg |= (1 << SREG_I);
+}
+
+static void Host_tickHandler(int signal_num)
+{
+	(void)signal_num;
+
+	if (Host_sreg & (1 << SREG_I))
+	{
+		Host_runPollFunctions();
+	}
+	else
+	{
+		/* Served by the next sei() or the next tick */
+		g_pollPending = 1;
+	}
+}
+
+static void Host_restoreTerminal(void)
+{
+	if (g_terminalChanged)
+	{
+		tcsetattr(STDIN_FILENO, TCSANOW, &g_savedTerminal);
+	}
+	fcntl(STDIN_FILENO, F_SETFL, g_savedStdinFlags);
+}
+
+static void Host_signalExit(int signal_num)
+{
+	Host_restoreTerminal();
+	_exit(128 + signal_num);
+}
+
+static void Host_init(void)
+{
+	struct sigaction action;
+	struct itimerval tick;
+	const char *speed = getenv("HOST_SPEED");
+
+	clock_gettime(CLOCK_MONOTONIC, &g_startTime);
+	if (speed != NULL && atoi(speed) > 0)
+	{
+		g_speed = (uint64)atoi(speed);
+	}
+
+	Board_init();
+
+	/* SIGALRM is blocked while its handler runs, so the ISRs never nest */
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = Host_tickHandler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+
+	tick.it_interval.tv_sec = 0;
+	tick.it_interval.tv_usec = HOST_TICK_US;
+	tick.it_value = tick.it_interval;
+	setitimer(ITIMER_REAL, &tick, NULL);
+}
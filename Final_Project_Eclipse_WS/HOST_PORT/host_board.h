@@ -0,0 +1,128 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: host_board.h
+ *
+ * Description: Header file for the Linux board of the ECUs host build
+ *
+ * The host build links the unmodified applications, services and HAL drivers
+ * of an ECU with Linux backends of gpio.c, uart.c, twi.c, timer1.c and pwm.c.
+ * This module gives those backends:
+ * 1. A virtual clock, the real time multiplied by HOST_SPEED (default 1).
+ * 2. Interrupts: a 1 ms SIGALRM calls the registered poll functions, which
+ *    play the role of the ISRs. They are held back while the emulated I-bit
+ *    in SREG is clear, exactly like the AVR holds back the interrupts.
+ * 3. The UART link to the other ECU and the keys typed for the keypad.
+ * 4. A board model hook (Board_*) for the devices wired to the GPIO pins.
+ *
+ * The simulator (sim_board.c) gives the same functions on a discrete-event
+ * clock, so the backends and board models are shared by both builds.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_BOARD_H_
+#define HOST_BOARD_H_
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Period of the SIGALRM that calls the poll functions, in real microseconds */
+#define HOST_TICK_US            1000
+
+/* Number of poll functions that can be registered */
+#define HOST_MAX_POLL_FUNCTIONS 8
+
+#ifndef HOST_ECU_NAME
+#define HOST_ECU_NAME "ECU"
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Register a function to be called from the host interrupt with interrupts disabled.
+ * Used by the backends in place of their ISRs.
+ */
+void Host_addPollFunction(void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Ask for the poll functions to be called at the given virtual time or soon after.
+ * Backends call it for every future event they wait for, as the simulator only
+ * calls the poll functions when one is due. The host interrupt ignores it.
+ */
+void Host_requestPoll(uint64 time_us);
+
+/*
+ * Description :
+ * Return the virtual time in microseconds since the process started.
+ */
+uint64 Host_getTimeUs(void);
+
+/*
+ * Description :
+ * Wait for the given virtual time, used by _delay_us() and _delay_ms().
+ */
+void Host_delayUs(unsigned long us);
+
+/*
+ * Description :
+ * Print one line to stdout prefixed with the virtual time and the ECU name.
+ * Safe to call from the poll functions.
+ */
+void Host_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/*
+ * Description :
+ * UART link to the other ECU. Host_linkRead never waits and returns FALSE
+ * when no byte is waiting, Host_linkWrite drops the bytes when not connected.
+ */
+void Host_linkInit(void);
+void Host_linkWrite(const uint8 *data_Ptr, uint8 size);
+boolean Host_linkRead(uint8 *data_Ptr);
+
+/*
+ * Description :
+ * Keys typed for the keypad. Host_readKey never waits and returns FALSE
+ * when no key is waiting.
+ */
+void Host_keysInit(void);
+boolean Host_readKey(uint8 *key_Ptr);
+
+/*
+ * Description :
+ * Functions of the board model of the ECU, called by the GPIO backend.
+ * Board_readPort returns the level driven by the board on every pin of the port,
+ * pins not driven by the board should read LOGIC_HIGH (internal pull-up).
+ * Board_portChanged is called after the MCU changed the output or direction of a port.
+ */
+void Board_init(void);
+uint8 Board_readPort(uint8 port_num);
+void Board_portChanged(uint8 port_num);
+
+/*
+ * Description :
+ * Return the output and direction registers of a port, for the board models.
+ */
+uint8 GPIO_getPortOutput(uint8 port_num);
+uint8 GPIO_getPortDirection(uint8 port_num);
+
+/*
+ * Description :
+ * Return the duty cycle of the PWM Timer0 signal in percent, for the board models.
+ */
+uint8 PWM_getDutyCycle(void);
+
+#endif /* HOST_BOARD_H_ */
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: host_launcher.c
+ *
+ * Description: Runs the two ECUs of the host build connected by their UARTs
+ *
+ * Usage: locker_system [control_ecu] [hmi_ecu], run from the build folder by default
+ * The ECUs are started with the two ends of a socketpair as HOST_UART_FD,
+ * the HMI ECU takes the keys from stdin and both print to stdout.
+ * The launcher ends when any of the ECUs ends, and stops the other one.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start one ECU with its end of the UART link, returns its process ID.
+ */
+static pid_t startEcu(const char *path, int uart_fd, int other_fd, int keep_stdin);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *control_path = (argc > 1) ? argv[1] : "./control/control_ecu";
+	const char *hmi_path = (argc > 2) ? argv[2] : "./hmi/hmi_ecu";
+	int link[2];
+	int status;
+	pid_t control_pid;
+	pid_t hmi_pid;
+	pid_t ended_pid;
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, link) != 0)
+	{
+		perror("socketpair");
+		return 1;
+	}
+
+	/* Ctrl+C reaches the ECUs directly, the launcher waits for them */
+	signal(SIGINT, SIG_IGN);
+
+	control_pid = startEcu(control_path, link[0], link[1], 0);
+	hmi_pid = startEcu(hmi_path, link[1], link[0], 1);
+	close(link[0]);
+	close(link[1]);
+
+	if (control_pid < 0 || hmi_pid < 0)
+	{
+		return 1;
+	}
+
+	ended_pid = wait(&status);
+	kill((ended_pid == control_pid) ? hmi_pid : control_pid, SIGTERM);
+	while (wait(NULL) > 0){}
+
+	return WIFEXITED(status) ? WEXITSTATUS(status) : 0;
+}
+
+static pid_t startEcu(const char *path, int uart_fd, int other_fd, int keep_stdin)
+{
+	char fd_name[12];
+	pid_t pid = fork();
+	int null_fd;
+
+	if (pid != 0)
+	{
+		if (pid < 0)
+		{
+			perror("fork");
+		}
+		return pid;
+	}
+
+	signal(SIGINT, SIG_DFL);
+	close(other_fd);
+
+	/* Only the HMI ECU has a keypad */
+	if (!keep_stdin)
+	{
+		null_fd = open("/dev/null", O_RDONLY);
+		dup2(null_fd, STDIN_FILENO);
+		close(null_fd);
+	}
+
+	snprintf(fd_name, sizeof(fd_name), "%d", uart_fd);
+	setenv("HOST_UART_FD", fd_name, 1);
+
+	execl(path, path, (char *)NULL);
+	perror(path);
+	_exit(127);
+}
@@ -0,0 +1,47 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: host_stdlib.c
+ *
+ * Description: avr-libc functions used by the ECUs that are not part of
+ * the C library on Linux, linked in every ECU of the host builds.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "std_types.h"
+#include <stdlib.h>
+
+/*
+ * Description :
+ * avr-libc itoa(), converts value to a string in the given base.
+ */
+char *itoa(int value, char *str, int base)
+{
+	char digits[34];
+	uint8 count = 0;
+	uint8 i = 0;
+	unsigned int magnitude = (value < 0 && base == 10) ? -(unsigned int)value : (unsigned int)value;
+
+	do
+	{
+		digits[count++] = "0123456789abcdefghijklmnopqrstuvwxyz"[magnitude % base];
+		magnitude /= base;
+	} while (magnitude != 0);
+
+	if (value < 0 && base == 10)
+	{
+		str[i++] = '-';
+	}
+	while (count != 0)
+	{
+		str[i++] = digits[--count];
+	}
+	str[i] = '\0';
+
+	return str;
+}
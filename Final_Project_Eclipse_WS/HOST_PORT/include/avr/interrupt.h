@@ -0,0 +1,30 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: interrupt.h
+ *
+ * Description: Replacement of <avr/interrupt.h> for the Linux build
+ * sei() and cli() set and clear the emulated I-bit in SREG, the host
+ * "interrupts" (signal handler) are held back while it is clear.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+void Host_enableInterrupts(void);
+void Host_disableInterrupts(void);
+
+#define sei() Host_enableInterrupts()
+#define cli() Host_disableInterrupts()
+
+/* Interrupt vectors become plain functions, nothing calls them on the host */
+#define ISR(vector) void vector(void); void vector(void)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,62 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: io.h
+ *
+ * Description: Replacement of <avr/io.h> for the Linux build
+ * Only the registers and bit names used outside the MCAL drivers are given,
+ * the drivers themselves are replaced by the host backends.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+/* Status register, only the global interrupt bit (I-bit) is used */
+extern volatile unsigned char Host_sreg;
+#define SREG Host_sreg
+
+#define SREG_I 7
+
+/* Port pins */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,27 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: pgmspace.h
+ *
+ * Description: Replacement of <avr/pgmspace.h> for the Linux build
+ * The host has one address space, flash data is read as normal data.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PGM_P                 const char *
+#define PSTR(s)               (s)
+
+#define pgm_read_byte(addr)   (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)   (*(const uint16_t *)(addr))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
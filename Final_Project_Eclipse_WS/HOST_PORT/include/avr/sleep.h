@@ -0,0 +1,28 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: sleep.h
+ *
+ * Description: Replacement of <avr/sleep.h> for the Linux build
+ * sleep_cpu() blocks the process until the next host "interrupt".
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_AVR_SLEEP_H_
+#define HOST_AVR_SLEEP_H_
+
+void Host_sleep(void);
+
+#define SLEEP_MODE_IDLE       0
+#define SLEEP_MODE_PWR_DOWN   2
+
+#define set_sleep_mode(mode)  ((void)(mode))
+#define sleep_enable()        ((void)0)
+#define sleep_disable()       ((void)0)
+#define sleep_cpu()           Host_sleep()
+
+#endif /* HOST_AVR_SLEEP_H_ */
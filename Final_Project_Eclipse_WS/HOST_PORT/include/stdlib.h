@@ -0,0 +1,21 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: stdlib.h
+ *
+ * Description: Adds the avr-libc itoa() to the C library <stdlib.h>
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_STDLIB_H_
+#define HOST_STDLIB_H_
+
+#include_next <stdlib.h>
+
+char *itoa(int value, char *str, int base);
+
+#endif /* HOST_STDLIB_H_ */
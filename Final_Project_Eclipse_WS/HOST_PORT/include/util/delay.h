@@ -0,0 +1,23 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: delay.h
+ *
+ * Description: Replacement of <util/delay.h> for the Linux build
+ * The delays run on the virtual clock of the host board.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+void Host_delayUs(unsigned long us);
+
+#define _delay_us(us) Host_delayUs((unsigned long)(us))
+#define _delay_ms(ms) Host_delayUs((unsigned long)(ms) * 1000UL)
+
+#endif /* HOST_UTIL_DELAY_H_ */
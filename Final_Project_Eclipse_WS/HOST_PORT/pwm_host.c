@@ -0,0 +1,55 @@
+/***************************************************************************
+ *
+ * Module Name: PWM
+ *
+ * File Name: pwm_host.c
+ *
+ * Description: Source file for the Linux backend of the PWM Timer0 Driver
+ * The duty cycle is logged and given to the board model, there is no Timer0 on the host.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/***************************************************************************
+ *								Inclusions
+ ***************************************************************************/
+#include "pwm.h"
+#include "gpio.h"
+#include "host_board.h"
+#include <avr/io.h>
+
+/***************************************************************************
+ *								Global Variables
+ ***************************************************************************/
+static uint8 g_dutyCycle = 0;
+
+/***************************************************************************
+ *								Functions Definitions
+ ***************************************************************************/
+
+void PWM_Timer0_Start(uint8 duty_cycle){
+	/* The OC0 pin is an output like on the AVR */
+	GPIO_setupPinDirection(PORTB_ID, OC0, PIN_OUTPUT);
+
+	PWM_Timer0_setDutyCycle(duty_cycle);
+}
+
+void PWM_Timer0_setDutyCycle(uint8 duty_cycle){
+	if (duty_cycle > PWM_MAX_DUTY_CYCLE){
+		duty_cycle = PWM_MAX_DUTY_CYCLE;
+	}
+	if (duty_cycle != g_dutyCycle){
+		g_dutyCycle = duty_cycle;
+		Host_log("PWM duty cycle %u%%", duty_cycle);
+
+		/* The motor speed follows the OC0 pin on PORTB */
+		Board_portChanged(PORTB_ID);
+	}
+}
+
+uint8 PWM_getDutyCycle(void){
+	return g_dutyCycle;
+}
@@ -0,0 +1,602 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: sim_board.c
+ *
+ * Description: Source file for the discrete-event simulator of the ECUs
+ *
+ * Every ECU runs on its own stack and gives the CPU back to the simulator
+ * only where the AVR would wait: sleep_cpu(), _delay_ms() and busy wait loops.
+ * The simulator then moves the virtual clock to the next due event and runs
+ * that ECU. The poll functions (the ISRs) of an ECU are called when it runs
+ * with the I-bit set and its earliest Host_requestPoll time has come.
+ *
+ * Busy wait loops, like waiting for a free place in the LCD queue, never call
+ * the simulator. A SIGPROF watchdog finds an ECU that ran SIM_WATCHDOG_US of
+ * CPU time without waiting and makes it wait for its next interrupt.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+
+/* The fortified longjmp refuses to jump between the stacks of the coroutines */
+#undef _FORTIFY_SOURCE
+#define _GNU_SOURCE
+#include "sim_board.h"
+#include "host_board.h"
+#include <avr/io.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_NEVER  (~(uint64)0)
+
+/* Why an ECU gave the CPU back to the simulator */
+typedef enum {
+	SIM_ECU_RUNNING, SIM_ECU_SLEEPING, SIM_ECU_DELAYING, SIM_ECU_SPINNING
+} Sim_EcuState;
+
+typedef struct {
+	const char *name;
+
+	/* Entry points and memory sections of the relocated ECU object */
+	int (*main_Ptr)(void);
+	void (*boardInit_Ptr)(void);
+#ifdef SCHEDULER_POWER_STATS
+	void (*reportPower_Ptr)(void (*a_report)(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current));
+#endif
+	char *data_start;
+	char *data_end;
+	char *bss_start;
+	char *bss_end;
+	char *data_image;
+
+	/* Coroutine */
+	ucontext_t start_context;
+	jmp_buf context;
+	char *stack;
+	boolean started;
+	Sim_EcuState state;
+	unsigned char sreg;
+
+	/* End of the running _delay_ms(), and the earliest requested poll */
+	uint64 resume_us;
+	uint64 wake_us;
+
+	void (*polls[HOST_MAX_POLL_FUNCTIONS])(void);
+	uint8 poll_count;
+
+	/* Bytes sent by the other ECU and not read yet */
+	uint8 link[SIM_LINK_SIZE];
+	uint16 link_head;
+	uint16 link_tail;
+
+	boolean has_keys;
+} Sim_EcuType;
+
+/*******************************************************************************
+ *                      External Symbols                                       *
+ *******************************************************************************/
+
+/* Renamed by objcopy when the ECU objects are relocated, see the Makefile */
+extern int Control_main(void);
+extern void Control_Board_init(void);
+extern int HMI_main(void);
+extern void HMI_Board_init(void);
+#ifdef SCHEDULER_POWER_STATS
+extern void Control_reportPowerStats(void (*a_report)(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current));
+extern void HMI_reportPowerStats(void (*a_report)(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current));
+#endif
+
+/* Section bounds given by the linker for the renamed sections */
+extern char __start_control_data[], __stop_control_data[];
+extern char __start_control_bss[], __stop_control_bss[];
+extern char __start_hmi_data[], __stop_hmi_data[];
+extern char __start_hmi_bss[], __stop_hmi_bss[];
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Emulated status register of the running ECU, swapped on every switch */
+volatile unsigned char Host_sreg = 0;
+
+static Sim_EcuType g_ecus[SIM_NUM_OF_ECUS] = {
+	{ .name = "CONTROL", .main_Ptr = Control_main, .boardInit_Ptr = Control_Board_init,
+#ifdef SCHEDULER_POWER_STATS
+	  .reportPower_Ptr = Control_reportPowerStats,
+#endif
+	  .data_start = __start_control_data, .data_end = __stop_control_data,
+	  .bss_start = __start_control_bss, .bss_end = __stop_control_bss },
+	{ .name = "HMI", .main_Ptr = HMI_main, .boardInit_Ptr = HMI_Board_init,
+#ifdef SCHEDULER_POWER_STATS
+	  .reportPower_Ptr = HMI_reportPowerStats,
+#endif
+	  .data_start = __start_hmi_data, .data_end = __stop_hmi_data,
+	  .bss_start = __start_hmi_bss, .bss_end = __stop_hmi_bss },
+};
+
+/* ECU running now, NULL while the simulator runs */
+static Sim_EcuType *g_current = NULL;
+static jmp_buf g_simContext;
+
+static uint64 g_now = 0;
+
+/* Keys typed for the ECU that opened the keys */
+static uint8 g_keys[SIM_KEYS_SIZE];
+static uint8 g_keysHead = 0;
+static uint8 g_keysTail = 0;
+
+/* Log line waited for by Sim_waitLog */
+static const Sim_EcuType *g_waitEcu = NULL;
+static const char *g_waitText = NULL;
+static boolean g_logMatched = FALSE;
+
+static boolean g_verbose = FALSE;
+
+/* Counted on every switch, the watchdog finds an ECU that did not switch */
+static volatile unsigned long g_switchCount = 0;
+static unsigned long g_watchedSwitchCount = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * First function of every ECU coroutine.
+ */
+static void Sim_ecuEntry(void);
+
+/*
+ * Description :
+ * Give the CPU back to the simulator from the running ECU.
+ */
+static void Sim_yield(Sim_EcuState state);
+
+/*
+ * Description :
+ * Run the given ECU until it waits again.
+ */
+static void Sim_switchTo(Sim_EcuType *ecu_Ptr);
+
+/*
+ * Description :
+ * Call the poll functions of the running ECU if one is due and the I-bit is set.
+ */
+static void Sim_serveInterrupts(void);
+
+/*
+ * Description :
+ * Return the virtual time when the ECU should run again.
+ */
+static uint64 Sim_dueTime(const Sim_EcuType *ecu_Ptr);
+
+/*
+ * Description :
+ * SIGPROF handler, stops an ECU that busy waits for an interrupt.
+ */
+static void Sim_watchdog(int signal_num);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Sim_init(void)
+{
+	struct sigaction action;
+	uint8 i;
+
+	for (i = 0; i < SIM_NUM_OF_ECUS; i++)
+	{
+		g_ecus[i].data_image = malloc(g_ecus[i].data_end - g_ecus[i].data_start);
+		memcpy(g_ecus[i].data_image, g_ecus[i].data_start, g_ecus[i].data_end - g_ecus[i].data_start);
+		g_ecus[i].stack = malloc(SIM_STACK_SIZE);
+	}
+
+	/* The backends read their options at initialization, the simulator keeps nothing on disk */
+	setenv("HOST_EEPROM_PATH", "", 1);
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = Sim_watchdog;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGPROF, &action, NULL);
+}
+
+void Sim_reset(void)
+{
+	Sim_EcuType *ecu_Ptr;
+	struct itimerval period;
+	uint8 i;
+
+	/* Started again on every run, the timers are not inherited by the worker processes */
+	period.it_interval.tv_sec = 0;
+	period.it_interval.tv_usec = SIM_WATCHDOG_US;
+	period.it_value = period.it_interval;
+	setitimer(ITIMER_PROF, &period, NULL);
+
+	g_now = 0;
+	g_keysHead = 0;
+	g_keysTail = 0;
+
+	for (i = 0; i < SIM_NUM_OF_ECUS; i++)
+	{
+		ecu_Ptr = &g_ecus[i];
+
+		memcpy(ecu_Ptr -> data_start, ecu_Ptr -> data_image, ecu_Ptr -> data_end - ecu_Ptr -> data_start);
+		memset(ecu_Ptr -> bss_start, 0, ecu_Ptr -> bss_end - ecu_Ptr -> bss_start);
+
+		ecu_Ptr -> started = FALSE;
+		ecu_Ptr -> state = SIM_ECU_RUNNING;
+		ecu_Ptr -> sreg = 0;
+		ecu_Ptr -> resume_us = 0;
+		ecu_Ptr -> wake_us = SIM_NEVER;
+		ecu_Ptr -> poll_count = 0;
+		ecu_Ptr -> link_head = 0;
+		ecu_Ptr -> link_tail = 0;
+		ecu_Ptr -> has_keys = FALSE;
+
+		getcontext(&ecu_Ptr -> start_context);
+		ecu_Ptr -> start_context.uc_stack.ss_sp = ecu_Ptr -> stack;
+		ecu_Ptr -> start_context.uc_stack.ss_size = SIM_STACK_SIZE;
+		ecu_Ptr -> start_context.uc_link = NULL;
+		makecontext(&ecu_Ptr -> start_context, Sim_ecuEntry, 0);
+
+		/* The board model is wired before power on, like in the processes build */
+		g_current = ecu_Ptr;
+		ecu_Ptr -> boardInit_Ptr();
+		g_current = NULL;
+	}
+}
+
+void Sim_typeKeys(const char *keys)
+{
+	uint8 i;
+
+	while (*keys != '\0' && ((g_keysHead + 1) % SIM_KEYS_SIZE) != g_keysTail)
+	{
+		g_keys[g_keysHead] = *keys++;
+		g_keysHead = (g_keysHead + 1) % SIM_KEYS_SIZE;
+	}
+
+	/* The keypad model takes them on its next poll */
+	for (i = 0; i < SIM_NUM_OF_ECUS; i++)
+	{
+		if (g_ecus[i].has_keys && g_ecus[i].wake_us > g_now)
+		{
+			g_ecus[i].wake_us = g_now;
+		}
+	}
+}
+
+boolean Sim_waitLog(uint8 ecu_num, const char *text, uint64 timeout_us)
+{
+	uint64 end_us = g_now + timeout_us;
+	uint64 due_us;
+	uint64 next_us;
+	Sim_EcuType *next_Ptr;
+	uint8 i;
+
+	g_waitEcu = &g_ecus[ecu_num];
+	g_waitText = text;
+	g_logMatched = FALSE;
+
+	while (!g_logMatched)
+	{
+		/* The ECU with the earliest event runs, the CONTROL ECU first on a tie */
+		next_Ptr = NULL;
+		next_us = SIM_NEVER;
+		for (i = 0; i < SIM_NUM_OF_ECUS; i++)
+		{
+			due_us = Sim_dueTime(&g_ecus[i]);
+			if (due_us < next_us)
+			{
+				next_us = due_us;
+				next_Ptr = &g_ecus[i];
+			}
+		}
+
+		if (next_Ptr == NULL || next_us > end_us)
+		{
+			g_now = end_us;
+			break;
+		}
+		if (next_us > g_now)
+		{
+			g_now = next_us;
+		}
+		Sim_switchTo(next_Ptr);
+	}
+
+	g_waitEcu = NULL;
+	return g_logMatched;
+}
+
+uint64 Sim_getTimeUs(void)
+{
+	return g_now;
+}
+
+void Sim_setVerbose(boolean verbose)
+{
+	g_verbose = verbose;
+}
+
+#ifdef SCHEDULER_POWER_STATS
+
+void Sim_reportPowerStats(uint8 ecu_num, void (*a_report)(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current))
+{
+	/* Runs the scheduler code of the ECU on the simulator stack, it only reads its counters */
+	g_ecus[ecu_num].reportPower_Ptr(a_report);
+}
+
+#endif
+
+/*******************************************************************************
+ *                      Host Board Functions                                   *
+ *******************************************************************************/
+
+void Host_addPollFunction(void(*a_ptr)(void))
+{
+	if (g_current -> poll_count < HOST_MAX_POLL_FUNCTIONS)
+	{
+		g_current -> polls[g_current -> poll_count] = a_ptr;
+		g_current -> poll_count++;
+	}
+}
+
+void Host_requestPoll(uint64 time_us)
+{
+	if (time_us < g_current -> wake_us)
+	{
+		g_current -> wake_us = time_us;
+	}
+}
+
+uint64 Host_getTimeUs(void)
+{
+	return g_now;
+}
+
+void Host_delayUs(unsigned long us)
+{
+	uint64 end_us = g_now + us;
+
+	for (;;)
+	{
+		/* Interrupts are served during the delay, like on the AVR */
+		Sim_serveInterrupts();
+		if (g_now >= end_us)
+		{
+			break;
+		}
+		g_current -> resume_us = end_us;
+		Sim_yield(SIM_ECU_DELAYING);
+	}
+}
+
+void Host_log(const char *format, ...)
+{
+	char line[160];
+	int length;
+	va_list args;
+
+	length = snprintf(line, sizeof(line), "[%5lu.%03lu %s] ",
+			(unsigned long)(g_now / 1000000ULL), (unsigned long)((g_now / 1000ULL) % 1000ULL), g_current -> name);
+
+	va_start(args, format);
+	length += vsnprintf(line + length, sizeof(line) - length, format, args);
+	va_end(args);
+
+	if (length > (int)sizeof(line) - 2)
+	{
+		length = sizeof(line) - 2;
+	}
+
+	if (g_current == g_waitEcu && strstr(line, g_waitText) != NULL)
+	{
+		g_logMatched = TRUE;
+	}
+
+	if (g_verbose)
+	{
+		line[length++] = '\n';
+		if (write(STDOUT_FILENO, line, length) < 0){}
+	}
+}
+
+void Host_linkInit(void)
+{
+}
+
+void Host_linkWrite(const uint8 *data_Ptr, uint8 size)
+{
+	Sim_EcuType *peer_Ptr = &g_ecus[(g_current == &g_ecus[0]) ? 1 : 0];
+	uint8 i;
+
+	/* Bytes are delivered at once, the UART of the other ECU gets them on its next poll */
+	for (i = 0; i < size; i++)
+	{
+		if (((peer_Ptr -> link_head + 1) % SIM_LINK_SIZE) == peer_Ptr -> link_tail)
+		{
+			break;
+		}
+		peer_Ptr -> link[peer_Ptr -> link_head] = data_Ptr[i];
+		peer_Ptr -> link_head = (peer_Ptr -> link_head + 1) % SIM_LINK_SIZE;
+	}
+
+	if (peer_Ptr -> wake_us > g_now)
+	{
+		peer_Ptr -> wake_us = g_now;
+	}
+}
+
+boolean Host_linkRead(uint8 *data_Ptr)
+{
+	if (g_current -> link_tail == g_current -> link_head)
+	{
+		return FALSE;
+	}
+	*data_Ptr = g_current -> link[g_current -> link_tail];
+	g_current -> link_tail = (g_current -> link_tail + 1) % SIM_LINK_SIZE;
+	return TRUE;
+}
+
+void Host_keysInit(void)
+{
+	g_current -> has_keys = TRUE;
+}
+
+boolean Host_readKey(uint8 *key_Ptr)
+{
+	if (!g_current -> has_keys || g_keysTail == g_keysHead)
+	{
+		return FALSE;
+	}
+	*key_Ptr = g_keys[g_keysTail];
+	g_keysTail = (g_keysTail + 1) % SIM_KEYS_SIZE;
+	return TRUE;
+}
+
+void Host_enableInterrupts(void)
+{
+	Host_sreg |= (1 << SREG_I);
+	Sim_serveInterrupts();
+}
+
+void Host_disableInterrupts(void)
+{
+	Host_sreg &= ~(1 << SREG_I);
+}
+
+void Host_sleep(void)
+{
+	Sim_yield(SIM_ECU_SLEEPING);
+	Sim_serveInterrupts();
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Sim_ecuEntry(void)
+{
+	g_current -> main_Ptr();
+
+	/* main() of an ECU never returns, stop the ECU if it does */
+	for (;;)
+	{
+		Host_sreg = 0;
+		Sim_yield(SIM_ECU_SLEEPING);
+	}
+}
+
+static void Sim_yield(Sim_EcuState state)
+{
+	g_current -> state = state;
+	g_current -> sreg = Host_sreg;
+
+	if (_setjmp(g_current -> context) == 0)
+	{
+		_longjmp(g_simContext, 1);
+	}
+}
+
+static void Sim_switchTo(Sim_EcuType *ecu_Ptr)
+{
+	g_switchCount++;
+	g_current = ecu_Ptr;
+	Host_sreg = ecu_Ptr -> sreg;
+	ecu_Ptr -> state = SIM_ECU_RUNNING;
+
+	if (_setjmp(g_simContext) == 0)
+	{
+		if (!ecu_Ptr -> started)
+		{
+			ecu_Ptr -> started = TRUE;
+			setcontext(&ecu_Ptr -> start_context);
+		}
+		_longjmp(ecu_Ptr -> context, 1);
+	}
+
+	g_current = NULL;
+}
+
+static void Sim_serveInterrupts(void)
+{
+	uint8 i;
+
+	if (!(Host_sreg & (1 << SREG_I)) || g_current -> wake_us > g_now)
+	{
+		return;
+	}
+
+	/* The I-bit is cleared while the ISRs run, they request their next poll again */
+	Host_sreg &= ~(1 << SREG_I);
+	g_current -> wake_us = SIM_NEVER;
+
+	for (i = 0; i < g_current -> poll_count; i++)
+	{
+		(*g_current -> polls[i])();
+	}
+
+	Host_sreg |= (1 << SREG_I);
+}
+
+static uint64 Sim_dueTime(const Sim_EcuType *ecu_Ptr)
+{
+	uint64 interrupt_us = (ecu_Ptr -> sreg & (1 << SREG_I)) ? ecu_Ptr -> wake_us : SIM_NEVER;
+
+	if (!ecu_Ptr -> started)
+	{
+		return g_now;
+	}
+
+	switch (ecu_Ptr -> state)
+	{
+	case SIM_ECU_DELAYING:
+		return (ecu_Ptr -> resume_us < interrupt_us) ? ecu_Ptr -> resume_us : interrupt_us;
+	default:
+		/* A sleeping or busy waiting ECU only runs again for an interrupt */
+		return interrupt_us;
+	}
+}
+
+static void Sim_watchdog(int signal_num)
+{
+	sigset_t signals;
+
+	(void)signal_num;
+
+	if (g_current == NULL || g_current -> state != SIM_ECU_RUNNING || g_switchCount != g_watchedSwitchCount)
+	{
+		g_watchedSwitchCount = g_switchCount;
+		return;
+	}
+
+	/* The ECU has not waited for a whole period, it waits for an interrupt in a loop */
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGPROF);
+	sigprocmask(SIG_UNBLOCK, &signals, NULL);
+
+	Sim_yield(SIM_ECU_SPINNING);
+	Sim_serveInterrupts();
+}
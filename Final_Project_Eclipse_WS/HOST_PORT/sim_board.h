@@ -0,0 +1,109 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: sim_board.h
+ *
+ * Description: Header file for the discrete-event simulator of the ECUs
+ *
+ * Both ECUs are linked into one process and run as coroutines on one virtual
+ * clock. The clock does not follow the real time: it jumps to the next event,
+ * which is a Timer1 interrupt, the end of a _delay_ms(), a UART byte or a typed
+ * key. Waiting 60 seconds of lockout costs only the code run during them.
+ *
+ * The simulator gives the host_board.h functions to the shared backends and
+ * board models, so the ECUs are the same code as in the processes build.
+ * Every ECU is one relocatable object with its own .data and .bss sections,
+ * which are restored by Sim_reset to start every scenario from power on.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef SIM_BOARD_H_
+#define SIM_BOARD_H_
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "std_types.h"
+#ifdef SCHEDULER_POWER_STATS
+#include "scheduler.h"
+#endif
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_CONTROL_ECU   0
+#define SIM_HMI_ECU       1
+#define SIM_NUM_OF_ECUS   2
+
+/* Stack of every ECU coroutine */
+#define SIM_STACK_SIZE    (256UL * 1024UL)
+
+/* Bytes on the way between the ECUs, and keys typed but not taken yet */
+#define SIM_LINK_SIZE     256
+#define SIM_KEYS_SIZE     64
+
+/* Real time an ECU may run without waiting before it is taken as busy waiting */
+#define SIM_WATCHDOG_US   2000
+
+#define SIM_MS(ms)        ((uint64)(ms) * 1000ULL)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Save the power on image of the ECUs memory and install the busy wait watchdog.
+ * Called once before the first scenario.
+ */
+void Sim_init(void);
+
+/*
+ * Description :
+ * Power on both ECUs: restore their memory, empty the link and the typed keys
+ * and set the virtual clock to 0. The ECUs run from main() on the next wait.
+ */
+void Sim_reset(void);
+
+/*
+ * Description :
+ * Type keys on the keypad of the HMI ECU, in the format of the keypad model.
+ */
+void Sim_typeKeys(const char *keys);
+
+/*
+ * Description :
+ * Run the ECUs until the given ECU logs a line containing text.
+ * Returns FALSE if it does not happen in timeout_us of virtual time.
+ */
+boolean Sim_waitLog(uint8 ecu_num, const char *text, uint64 timeout_us);
+
+/*
+ * Description :
+ * Return the virtual time of the running scenario in microseconds.
+ */
+uint64 Sim_getTimeUs(void);
+
+/*
+ * Description :
+ * Print the log lines of the ECUs to stdout, off by default.
+ */
+void Sim_setVerbose(boolean verbose);
+
+#ifdef SCHEDULER_POWER_STATS
+
+/*
+ * Description :
+ * Pass the power statistics of every measured state of the given ECU to a_report,
+ * measured by its scheduler since the last Sim_reset.
+ */
+void Sim_reportPowerStats(uint8 ecu_num, void (*a_report)(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current));
+
+#endif
+
+#endif /* SIM_BOARD_H_ */
@@ -0,0 +1,421 @@
+/***************************************************************************
+ *
+ * Module Name: Host Port
+ *
+ * File Name: sim_main.c
+ *
+ * Description: Door cycle scenarios run on the discrete-event simulator
+ *
+ *   locker_sim [-n runs] [-j jobs] [-v] [-p file] [scenario ...]
+ *
+ *   -n   runs of every scenario (default 1000)
+ *   -j   worker processes sharing the runs (default 1)
+ *   -v   print the log lines of the ECUs, one run only
+ *   -p   power build only (SCHEDULER_POWER_STATS): write the power statistics
+ *        of the last run of every scenario to file, the runs are not shared
+ *
+ * Every run powers on both ECUs with an erased EEPROM, plays the scenario
+ * on the keypad and checks the LCD, motor and buzzer on the ECU logs.
+ * The report gives the simulated time against the wall-clock time.
+ *
+ * The power file has one tab separated line per application state of each ECU:
+ *   scenario  ecu  state  active_us  idle_us  events  current_ua
+ * state is the value of the Control_State or HMI_State of the application.
+ * The CPU takes no virtual time to run code, so the power build charges the
+ * cycles of POWER_EVENT_CYCLES (Makefile) for every handled event, and the
+ * active time is those cycles and the busy waits, like _delay_ms().
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "sim_board.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SIM_MAX_JOBS   64
+
+/* Times of the applications, with a margin for the messages and the UART */
+#define DOOR_MOVE_TIMEOUT_MS   16000
+#define DOOR_HOLD_TIMEOUT_MS   4000
+#define LOCKOUT_TIMEOUT_MS     61000
+#define STEP_TIMEOUT_MS        3000
+
+#define PASSWORD        "12345\n"
+#define WRONG_PASSWORD  "11111\n"
+
+typedef struct {
+	const char *name;
+	boolean (*run_Ptr)(void);
+} Sim_ScenarioType;
+
+/* Results of the runs of one scenario, also passed from the workers through a pipe */
+typedef struct {
+	unsigned long runs;
+	unsigned long passed;
+	uint64 simulated_us;
+} Sim_ResultType;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+static boolean Scenario_createPassword(void);
+static boolean Scenario_unlock(void);
+static boolean Scenario_lockout(void);
+
+/*
+ * Description :
+ * Run a scenario the given number of times, in this process.
+ */
+static void Sim_runScenario(const Sim_ScenarioType *scenario_Ptr, unsigned long runs, Sim_ResultType *result_Ptr);
+
+/*
+ * Description :
+ * Run a scenario shared by jobs worker processes and add up their results.
+ */
+static void Sim_runJobs(const Sim_ScenarioType *scenario_Ptr, unsigned long runs, uint8 jobs, Sim_ResultType *result_Ptr);
+
+static double Sim_wallSeconds(void);
+
+#ifdef SCHEDULER_POWER_STATS
+
+/*
+ * Description :
+ * Write the power statistics of both ECUs, from the last run of the scenario.
+ */
+static void Sim_writePowerStats(const char *scenario_name);
+
+/*
+ * Description :
+ * Write one line of the power file, called by Sim_reportPowerStats.
+ */
+static void Sim_writePowerState(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current);
+
+#endif
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static const Sim_ScenarioType g_scenarios[] = {
+	{"unlock", Scenario_unlock},
+	{"lockout", Scenario_lockout},
+};
+
+#ifdef SCHEDULER_POWER_STATS
+
+/* Power file, and the scenario and ECU of the lines written to it */
+static FILE *g_powerFile = NULL;
+static const char *g_powerScenario;
+static const char *g_powerEcu;
+
+#endif
+
+/*******************************************************************************
+ *                      Scenarios                                              *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Power on with an erased EEPROM and save PASSWORD, ends on the main options.
+ */
+static boolean Scenario_createPassword(void)
+{
+	Sim_reset();
+
+	if (!Sim_waitLog(SIM_HMI_ECU, "New Password", SIM_MS(STEP_TIMEOUT_MS)))
+	{
+		return FALSE;
+	}
+	Sim_typeKeys(PASSWORD);
+	if (!Sim_waitLog(SIM_HMI_ECU, "Please Re-enter", SIM_MS(STEP_TIMEOUT_MS)))
+	{
+		return FALSE;
+	}
+	Sim_typeKeys(PASSWORD);
+	return Sim_waitLog(SIM_HMI_ECU, "+ : Open Door", SIM_MS(STEP_TIMEOUT_MS));
+}
+
+/*
+ * Description :
+ * Open the door with the right password and follow it to the main options again.
+ */
+static boolean Scenario_unlock(void)
+{
+	if (!Scenario_createPassword())
+	{
+		return FALSE;
+	}
+
+	Sim_typeKeys("+" PASSWORD);
+	return Sim_waitLog(SIM_CONTROL_ECU, "Motor CLOCKWISE", SIM_MS(STEP_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_HMI_ECU, "Door is Open", SIM_MS(DOOR_MOVE_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_CONTROL_ECU, "Motor ANTI-CLOCKWISE", SIM_MS(DOOR_HOLD_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_CONTROL_ECU, "Motor STOP", SIM_MS(DOOR_MOVE_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_HMI_ECU, "+ : Open Door", SIM_MS(STEP_TIMEOUT_MS));
+}
+
+/*
+ * Description :
+ * Enter a wrong password three times, the system is locked with the buzzer on
+ * and goes back to the main options after the lock time.
+ */
+static boolean Scenario_lockout(void)
+{
+	uint8 attempt;
+
+	if (!Scenario_createPassword())
+	{
+		return FALSE;
+	}
+
+	/* The password is asked again after a wrong one, without the main options */
+	Sim_typeKeys("+");
+	for (attempt = 0; attempt < 2; attempt++)
+	{
+		Sim_typeKeys(WRONG_PASSWORD);
+		if (!Sim_waitLog(SIM_HMI_ECU, "Wrong Password", SIM_MS(STEP_TIMEOUT_MS))
+				|| !Sim_waitLog(SIM_HMI_ECU, "Please Enter", SIM_MS(STEP_TIMEOUT_MS)))
+		{
+			return FALSE;
+		}
+	}
+
+	Sim_typeKeys(WRONG_PASSWORD);
+	return Sim_waitLog(SIM_CONTROL_ECU, "Buzzer ON", SIM_MS(STEP_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_HMI_ECU, "System is Locked", SIM_MS(STEP_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_CONTROL_ECU, "Buzzer OFF", SIM_MS(LOCKOUT_TIMEOUT_MS))
+			&& Sim_waitLog(SIM_HMI_ECU, "+ : Open Door", SIM_MS(STEP_TIMEOUT_MS));
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	unsigned long runs = 1000;
+	uint8 jobs = 1;
+	boolean verbose = FALSE;
+	boolean selected;
+	Sim_ResultType result;
+	double start_time;
+	double wall_time;
+	double simulated_time;
+	uint8 i;
+	int option;
+	int arg;
+	int failed = 0;
+
+#ifdef SCHEDULER_POWER_STATS
+	const char *power_path = NULL;
+#endif
+
+	while ((option = getopt(argc, argv, "n:j:vp:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n':
+			runs = strtoul(optarg, NULL, 10);
+			break;
+		case 'j':
+			jobs = (uint8)atoi(optarg);
+			break;
+		case 'v':
+			verbose = TRUE;
+			break;
+#ifdef SCHEDULER_POWER_STATS
+		case 'p':
+			power_path = optarg;
+			break;
+#endif
+		default:
+			fprintf(stderr, "usage: %s [-n runs] [-j jobs] [-v] [-p file] [scenario ...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+#ifdef SCHEDULER_POWER_STATS
+	if (power_path != NULL)
+	{
+		g_powerFile = fopen(power_path, "w");
+		if (g_powerFile == NULL)
+		{
+			perror(power_path);
+			return 2;
+		}
+		fprintf(g_powerFile, "scenario\tecu\tstate\tactive_us\tidle_us\tevents\tcurrent_ua\n");
+
+		/* The statistics are read from the memory of the ECUs after the last run, in this process */
+		jobs = 1;
+	}
+#endif
+
+	if (verbose)
+	{
+		runs = 1;
+		jobs = 1;
+	}
+	if (jobs < 1 || jobs > SIM_MAX_JOBS)
+	{
+		jobs = 1;
+	}
+
+	Sim_init();
+	Sim_setVerbose(verbose);
+
+	printf("%-10s %8s %8s %12s %10s %12s %12s\n",
+			"scenario", "runs", "passed", "simulated s", "wall s", "runs/s", "speed-up");
+
+	for (i = 0; i < sizeof(g_scenarios) / sizeof(g_scenarios[0]); i++)
+	{
+		selected = (optind == argc);
+		for (arg = optind; arg < argc; arg++)
+		{
+			selected |= (strcmp(argv[arg], g_scenarios[i].name) == 0);
+		}
+		if (!selected)
+		{
+			continue;
+		}
+
+		start_time = Sim_wallSeconds();
+		Sim_runJobs(&g_scenarios[i], runs, jobs, &result);
+		wall_time = Sim_wallSeconds() - start_time;
+		simulated_time = result.simulated_us / 1e6;
+
+		printf("%-10s %8lu %8lu %12.1f %10.3f %12.1f %11.0fx\n", g_scenarios[i].name,
+				result.runs, result.passed, simulated_time, wall_time,
+				result.runs / wall_time, simulated_time / wall_time);
+		fflush(stdout);
+
+		if (result.passed != result.runs)
+		{
+			failed = 1;
+		}
+
+#ifdef SCHEDULER_POWER_STATS
+		if (g_powerFile != NULL)
+		{
+			Sim_writePowerStats(g_scenarios[i].name);
+		}
+#endif
+	}
+
+#ifdef SCHEDULER_POWER_STATS
+	if (g_powerFile != NULL)
+	{
+		fclose(g_powerFile);
+	}
+#endif
+
+	return failed;
+}
+
+static void Sim_runScenario(const Sim_ScenarioType *scenario_Ptr, unsigned long runs, Sim_ResultType *result_Ptr)
+{
+	unsigned long run;
+
+	memset(result_Ptr, 0, sizeof(*result_Ptr));
+	for (run = 0; run < runs; run++)
+	{
+		if (scenario_Ptr -> run_Ptr())
+		{
+			result_Ptr -> passed++;
+		}
+		result_Ptr -> runs++;
+		result_Ptr -> simulated_us += Sim_getTimeUs();
+	}
+}
+
+static void Sim_runJobs(const Sim_ScenarioType *scenario_Ptr, unsigned long runs, uint8 jobs, Sim_ResultType *result_Ptr)
+{
+	int pipes[SIM_MAX_JOBS][2];
+	Sim_ResultType job_result;
+	unsigned long job_runs;
+	uint8 job;
+
+	if (jobs == 1)
+	{
+		Sim_runScenario(scenario_Ptr, runs, result_Ptr);
+		return;
+	}
+
+	memset(result_Ptr, 0, sizeof(*result_Ptr));
+	for (job = 0; job < jobs; job++)
+	{
+		job_runs = runs / jobs + ((job < runs % jobs) ? 1 : 0);
+		if (pipe(pipes[job]) < 0)
+		{
+			pipes[job][0] = -1;
+			continue;
+		}
+		if (fork() == 0)
+		{
+			close(pipes[job][0]);
+			Sim_runScenario(scenario_Ptr, job_runs, &job_result);
+			if (write(pipes[job][1], &job_result, sizeof(job_result)) < 0){}
+			_exit(0);
+		}
+		close(pipes[job][1]);
+	}
+
+	for (job = 0; job < jobs; job++)
+	{
+		if (pipes[job][0] >= 0 && read(pipes[job][0], &job_result, sizeof(job_result)) == sizeof(job_result))
+		{
+			result_Ptr -> runs += job_result.runs;
+			result_Ptr -> passed += job_result.passed;
+			result_Ptr -> simulated_us += job_result.simulated_us;
+		}
+		if (pipes[job][0] >= 0)
+		{
+			close(pipes[job][0]);
+		}
+	}
+	while (wait(NULL) > 0){}
+}
+
+static double Sim_wallSeconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+#ifdef SCHEDULER_POWER_STATS
+
+static void Sim_writePowerStats(const char *scenario_name)
+{
+	g_powerScenario = scenario_name;
+
+	g_powerEcu = "CONTROL";
+	Sim_reportPowerStats(SIM_CONTROL_ECU, Sim_writePowerState);
+
+	g_powerEcu = "HMI";
+	Sim_reportPowerStats(SIM_HMI_ECU, Sim_writePowerState);
+}
+
+static void Sim_writePowerState(uint8 state, const Scheduler_PowerStatsType *stats_Ptr, uint16 current)
+{
+	fprintf(g_powerFile, "%s\t%s\t%u\t%lu\t%lu\t%lu\t%u\n", g_powerScenario, g_powerEcu, state,
+			(unsigned long)stats_Ptr -> active_us, (unsigned long)stats_Ptr -> idle_us,
+			(unsigned long)stats_Ptr -> events, current);
+}
+
+#endif
@@ -0,0 +1,135 @@
+/***************************************************************************
+ *
+ * Module Name: Timer1
+ *
+ * File Name: timer1_host.c
+ *
+ * Description: Source file for the Linux backend of the Timer1 Driver
+ * The timer counts on the virtual clock of the host board.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "timer1.h"
+#include "host_board.h"
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+
+/* Interrupts that may be served late in one host tick, the rest are dropped */
+#define TIMER1_MAX_CATCH_UP 8
+
+/*******************************************************************************
+ * 								 Global Variables
+ *******************************************************************************/
+static void (*volatile g_Timer1_Call_Back) (void) = NULL_PTR;
+
+/* Interrupt period and the virtual time of the next interrupt, 0 period when stopped */
+static volatile uint64 g_periodUs = 0;
+static volatile uint64 g_nextInterruptUs = 0;
+
+/* Timer clock of the running configuration, for the counter */
+static uint16 g_prescaler = 0;
+
+static boolean g_pollRegistered = FALSE;
+
+/*******************************************************************************
+ * 								 Functions Prototypes(Private)
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Host interrupt poll function, calls the call-back function for every period passed
+ */
+static void Timer1_poll(void);
+
+/*******************************************************************************
+ * 								 Functions Definitions
+ *******************************************************************************/
+void Timer1_init(const Timer1_ConfigType * Config_Ptr){
+	static const uint16 prescaler_values[] = {0, 1, 8, 64, 256, 1024, 0, 0};
+	uint16 prescaler = prescaler_values[Config_Ptr -> prescaler];
+	uint32 counts;
+
+	if (!g_pollRegistered){
+		Host_addPollFunction(Timer1_poll);
+		g_pollRegistered = TRUE;
+	}
+
+	/* No clock source, or the external T1 pin which is not wired on the host */
+	if (prescaler == 0){
+		g_periodUs = 0;
+		return;
+	}
+
+	/* Compare match clears the counter, overflow restarts it from the initial value */
+	if (Config_Ptr -> mode == COMPARE_MODE){
+		counts = (uint32)Config_Ptr -> compare_value + 1;
+	}
+	else{
+		counts = 65536UL - Config_Ptr -> initial_value;
+	}
+
+	g_prescaler = prescaler;
+	g_periodUs = ((uint64)counts * prescaler * 1000000ULL) / F_CPU;
+	if (g_periodUs == 0){
+		g_periodUs = 1;
+	}
+	g_nextInterruptUs = Host_getTimeUs() + g_periodUs;
+	Host_requestPoll(g_nextInterruptUs);
+}
+
+void Timer1_setCallBack(void(*a_ptr)(void)){
+	g_Timer1_Call_Back = a_ptr;
+}
+
+void Timer1_deInit(void){
+	g_periodUs = 0;
+}
+
+uint16 Timer1_getCount(boolean * pending_Ptr){
+	uint64 now = Host_getTimeUs();
+	uint64 elapsed_us;
+
+	if (g_periodUs == 0){
+		*pending_Ptr = FALSE;
+		return 0;
+	}
+
+	/* The poll function serves the interrupt soon after its time, until then it is pending */
+	*pending_Ptr = (now >= g_nextInterruptUs) ? TRUE : FALSE;
+	elapsed_us = (now + g_periodUs - g_nextInterruptUs) % g_periodUs;
+
+	return (uint16)((elapsed_us * (F_CPU / 1000000UL)) / g_prescaler);
+}
+
+static void Timer1_poll(void){
+	uint64 now = Host_getTimeUs();
+	uint8 count = 0;
+
+	if (g_periodUs == 0){
+		return;
+	}
+
+	while (now >= g_nextInterruptUs){
+		if (count == TIMER1_MAX_CATCH_UP){
+			/* The process was stopped for long, like the AVR lost interrupts */
+			g_nextInterruptUs = now + g_periodUs;
+			break;
+		}
+		g_nextInterruptUs += g_periodUs;
+		count++;
+
+		if (g_Timer1_Call_Back != NULL_PTR){
+			(*g_Timer1_Call_Back)();
+		}
+	}
+	Host_requestPoll(g_nextInterruptUs);
+}
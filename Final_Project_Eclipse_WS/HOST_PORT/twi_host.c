@@ -0,0 +1,315 @@
+/***************************************************************************
+ *
+ * Module Name: TWI
+ *
+ * File Name: twi_host.c
+ *
+ * Description: Source file for the Linux backend of the TWI Driver
+ *
+ * The bus has one device, a 24C16 EEPROM (2 KB, 16-byte pages) at 0XA0,
+ * kept in the file HOST_EEPROM_PATH (default eeprom.bin).
+ * The EEPROM NACKs its address for EEPROM_WRITE_CYCLE_US after every write
+ * like the real device, so the ACK polling of the EEPROM driver is exercised.
+ * An empty HOST_EEPROM_PATH keeps the memory in RAM only.
+ * Every transaction takes its bus time (9 bits per byte) on the virtual clock.
+ *
+ * Created on: Nov 20, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+#include "twi.h"
+#include "host_board.h"
+#include <avr/interrupt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                      Definitions                                            *
+ *******************************************************************************/
+#define EEPROM_DEVICE_ADDRESS  0XA0
+#define EEPROM_DEVICE_MASK     0XF0
+#define EEPROM_MEMORY_SIZE     2048
+#define EEPROM_PAGE_MASK       0X0F
+#define EEPROM_WRITE_CYCLE_US  5000
+
+/* Bits on the bus for every byte (8 data bits and ACK), and for the start and stop bits */
+#define TWI_BITS_PER_BYTE      9
+#define TWI_BITS_PER_FRAME     2
+
+/* Bus phases of the byte level model */
+typedef enum {
+	TWI_BUS_IDLE, TWI_BUS_ADDRESS, TWI_BUS_WORD_ADDRESS, TWI_BUS_WRITE, TWI_BUS_READ, TWI_BUS_NACK
+} TWI_BusPhase;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static uint8 g_memory[EEPROM_MEMORY_SIZE];
+static int g_memoryFd = -1;
+
+/* Internal address counter of the EEPROM */
+static uint16 g_address = 0;
+
+/* Page written in the running write, programmed at the stop bit */
+static uint8 g_pageData[EEPROM_PAGE_MASK + 1];
+static uint8 g_pageWritten = 0;
+static uint16 g_pageAddress = 0;
+
+/* Virtual time when the running write cycle ends */
+static uint64 g_writeCycleEndUs = 0;
+
+static uint32 g_bitRate = BIT_RATE_100_KBS;
+
+static TWI_BusPhase g_phase = TWI_BUS_IDLE;
+static uint8 g_status = 0XF8;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Program the page written since the start bit into the memory and the file.
+ */
+static void TWI_programPage(void);
+
+/*
+ * Description:
+ * Send one byte on the bus and return the new status.
+ */
+static uint8 TWI_busWrite(uint8 data);
+
+/*
+ * Description:
+ * Run one transaction on the bus and return its final state.
+ */
+static TWI_TransactionStatus TWI_runTransaction(const TWI_TransactionType * transaction_Ptr);
+
+void TWI_init(const TWI_ConfigType * Config_Ptr)
+{
+	const char *path = getenv("HOST_EEPROM_PATH");
+
+	g_bitRate = Config_Ptr -> bit_rate;
+
+	if (g_memoryFd >= 0)
+	{
+		return;
+	}
+
+	/* A new EEPROM is erased to 0XFF */
+	memset(g_memory, 0XFF, sizeof(g_memory));
+
+	if (path != NULL && path[0] == '\0')
+	{
+		return;
+	}
+
+	g_memoryFd = open((path != NULL) ? path : "eeprom.bin", O_RDWR | O_CREAT, 0644);
+	if (g_memoryFd < 0)
+	{
+		Host_log("EEPROM file can not be opened, the memory is not kept");
+		return;
+	}
+	if (read(g_memoryFd, g_memory, sizeof(g_memory)) != (ssize_t)sizeof(g_memory))
+	{
+		memset(g_memory, 0XFF, sizeof(g_memory));
+		if (pwrite(g_memoryFd, g_memory, sizeof(g_memory), 0) < 0){}
+	}
+}
+
+void TWI_start(void)
+{
+	g_status = (g_phase == TWI_BUS_IDLE) ? TWI_START : TWI_REP_START;
+	TWI_programPage();
+	g_phase = TWI_BUS_ADDRESS;
+}
+
+void TWI_stop(void)
+{
+	TWI_programPage();
+	g_phase = TWI_BUS_IDLE;
+	g_status = 0XF8;
+}
+
+void TWI_writeByte(uint8 data)
+{
+	g_status = TWI_busWrite(data);
+}
+
+uint8 TWI_readByteWithACK(void)
+{
+	uint8 data = g_memory[g_address];
+
+	g_address = (g_address + 1) % EEPROM_MEMORY_SIZE;
+	g_status = TWI_MR_DATA_ACK;
+	return data;
+}
+
+uint8 TWI_readByteWithNACK(void)
+{
+	uint8 data = g_memory[g_address];
+
+	g_address = (g_address + 1) % EEPROM_MEMORY_SIZE;
+	g_status = TWI_MR_DATA_NACK;
+	return data;
+}
+
+uint8 TWI_getStatus(void)
+{
+	return g_status;
+}
+
+/*
+ * Description:
+ * Run the transaction on the bus after its bus time, the bus of the host is never busy.
+ * The call-back function is called with interrupts disabled like from the ISR.
+ */
+boolean TWI_submitTransaction(TWI_TransactionType * transaction_Ptr)
+{
+	uint8 sreg;
+	uint32 bits = TWI_BITS_PER_FRAME + TWI_BITS_PER_BYTE * (1 + transaction_Ptr -> write_size);
+
+	if (transaction_Ptr -> read_size != 0)
+	{
+		bits += TWI_BITS_PER_FRAME + TWI_BITS_PER_BYTE * (1 + transaction_Ptr -> read_size);
+	}
+
+	/* The CPU is free while the bus works, like waiting for the TWI ISR */
+	Host_delayUs((bits * 1000000UL + g_bitRate - 1) / g_bitRate);
+
+	sreg = SREG;
+	cli();
+	transaction_Ptr -> status = TWI_runTransaction(transaction_Ptr);
+	if (transaction_Ptr -> callBack_Ptr != NULL_PTR)
+	{
+		transaction_Ptr -> callBack_Ptr(transaction_Ptr);
+	}
+	SREG = sreg;
+
+	return TRUE;
+}
+
+TWI_TransactionStatus TWI_waitTransaction(const TWI_TransactionType * transaction_Ptr)
+{
+	return transaction_Ptr -> status;
+}
+
+boolean TWI_isBusy(void)
+{
+	return FALSE;
+}
+
+static void TWI_programPage(void)
+{
+	uint8 i;
+
+	if (g_pageWritten == 0)
+	{
+		return;
+	}
+
+	/* Bytes after the end of the page roll over to its start, like the real device */
+	for (i = 0; i < g_pageWritten && i <= EEPROM_PAGE_MASK; i++)
+	{
+		g_memory[(g_pageAddress & ~EEPROM_PAGE_MASK) | ((g_pageAddress + i) & EEPROM_PAGE_MASK)] = g_pageData[i];
+	}
+	g_pageWritten = 0;
+	g_writeCycleEndUs = Host_getTimeUs() + EEPROM_WRITE_CYCLE_US;
+
+	if (g_memoryFd >= 0)
+	{
+		if (pwrite(g_memoryFd, &g_memory[g_pageAddress & ~EEPROM_PAGE_MASK], EEPROM_PAGE_MASK + 1,
+				g_pageAddress & ~EEPROM_PAGE_MASK) < 0){}
+	}
+}
+
+static uint8 TWI_busWrite(uint8 data)
+{
+	switch (g_phase)
+	{
+	case TWI_BUS_ADDRESS:
+		/* No other device on the bus, and the EEPROM is deaf during its write cycle */
+		if ((data & EEPROM_DEVICE_MASK) != EEPROM_DEVICE_ADDRESS || Host_getTimeUs() < g_writeCycleEndUs)
+		{
+			g_phase = TWI_BUS_NACK;
+			return (data & 0X01) ? TWI_MT_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+		}
+		if (data & 0X01)
+		{
+			g_phase = TWI_BUS_READ;
+			return TWI_MT_SLA_R_ACK;
+		}
+		/* The block select bits are the high bits of the memory address */
+		g_address = (uint16)((data >> 1) & 0X07) << 8;
+		g_phase = TWI_BUS_WORD_ADDRESS;
+		return TWI_MT_SLA_W_ACK;
+
+	case TWI_BUS_WORD_ADDRESS:
+		g_address |= data;
+		g_pageAddress = g_address;
+		g_pageWritten = 0;
+		g_phase = TWI_BUS_WRITE;
+		return TWI_MT_DATA_ACK;
+
+	case TWI_BUS_WRITE:
+		g_pageData[g_pageWritten & EEPROM_PAGE_MASK] = data;
+		if (g_pageWritten <= EEPROM_PAGE_MASK)
+		{
+			g_pageWritten++;
+		}
+		return TWI_MT_DATA_ACK;
+
+	default:
+		return TWI_MT_DATA_NACK;
+	}
+}
+
+static TWI_TransactionStatus TWI_runTransaction(const TWI_TransactionType * transaction_Ptr)
+{
+	uint8 i;
+	TWI_TransactionStatus status = TWI_TRANSACTION_DONE;
+
+	TWI_start();
+	TWI_writeByte(transaction_Ptr -> slave_address & 0XFE);
+	if (TWI_getStatus() != TWI_MT_SLA_W_ACK)
+	{
+		TWI_stop();
+		return TWI_TRANSACTION_ADDRESS_NACK;
+	}
+
+	for (i = 0; i < transaction_Ptr -> write_size; i++)
+	{
+		TWI_writeByte(transaction_Ptr -> write_Ptr[i]);
+		if (TWI_getStatus() != TWI_MT_DATA_ACK)
+		{
+			TWI_stop();
+			return TWI_TRANSACTION_DATA_NACK;
+		}
+	}
+
+	if (transaction_Ptr -> read_size != 0)
+	{
+		TWI_start();
+		TWI_writeByte(transaction_Ptr -> slave_address | 0X01);
+		if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
+		{
+			status = TWI_TRANSACTION_ADDRESS_NACK;
+		}
+		else
+		{
+			for (i = 0; i < transaction_Ptr -> read_size - 1; i++)
+			{
+				transaction_Ptr -> read_Ptr[i] = TWI_readByteWithACK();
+			}
+			transaction_Ptr -> read_Ptr[i] = TWI_readByteWithNACK();
+		}
+	}
+
+	TWI_stop();
+	return status;
+}
@@ -0,0 +1,212 @@
+ /******************************************************************************
+ *
+ * Module: UART
+ *
+ * File Name: uart_host.c
+ *
+ * Description: Source file for the Linux backend of the UART driver
+ * The bytes go through the link to the other ECU given by the host board.
+ *
+ * Author: Omar EL-Sheikh
+ *
+ *******************************************************************************/
+
+#include "uart.h"
+#include "host_board.h"
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define UART_RX_BUFFER_MASK (UART_RX_BUFFER_SIZE - 1)
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+static boolean g_pollRegistered = FALSE;
+
+/* Selected driver mode, saved at initialization */
+static UART_Mode g_uartMode = UART_POLLING_MODE;
+
+/* RX ring buffer, head is written by the poll function and tail by the application */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+static volatile uint16 g_rxOverrunCount = 0;
+
+/* Call-back function called when a byte is received in interrupt mode */
+static void (*volatile g_UART_RxCallBack)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Host interrupt poll function, moves the received bytes to the RX buffer.
+ */
+static void UART_poll(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Open the link to the other ECU and empty the RX buffer.
+ * The frame format and baud rate are not used, bytes are passed as they are.
+ */
+void UART_init(const UART_ConfigType * UART_Configs_Ptr)
+{
+	uint8 sreg = SREG;
+
+	cli();
+	g_uartMode = UART_Configs_Ptr -> mode;
+	g_rxHead = 0;
+	g_rxTail = 0;
+	SREG = sreg;
+
+	Host_linkInit();
+	if (!g_pollRegistered)
+	{
+		Host_addPollFunction(UART_poll);
+		g_pollRegistered = TRUE;
+	}
+}
+
+/*
+ * Description :
+ * Functional responsible for send byte to another UART device.
+ */
+void UART_sendByte(const uint8 data)
+{
+	UART_write(&data, 1);
+}
+
+/*
+ * Description :
+ * Functional responsible for receive byte from another UART device.
+ */
+uint8 UART_recieveByte(void)
+{
+	uint8 data;
+
+	/* Wait until the poll function puts a byte in the RX buffer */
+	while(!UART_tryReceive(&data)){}
+	return data;
+}
+
+/*
+ * Description :
+ * Take a received byte if there is one without waiting.
+ * Returns TRUE and stores the byte in data_Ptr if a byte was available, FALSE otherwise.
+ */
+boolean UART_tryReceive(uint8 *data_Ptr)
+{
+	if (g_rxHead == g_rxTail)
+	{
+		return FALSE;
+	}
+	*data_Ptr = g_rxBuffer[g_rxTail];
+	g_rxTail = (g_rxTail + 1) & UART_RX_BUFFER_MASK;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Send size bytes to the other ECU.
+ * The host link has no small TX buffer, so all the bytes are always accepted.
+ */
+uint8 UART_write(const uint8 *data_Ptr, uint8 size)
+{
+	Host_linkWrite(data_Ptr, size);
+	return size;
+}
+
+/*
+ * Description :
+ * Return the number of received bytes dropped because the RX buffer was full.
+ */
+uint16 UART_getRxOverrunCount(void)
+{
+	return g_rxOverrunCount;
+}
+
+/*
+ * Description :
+ * Return the number of Data OverRun errors (DOR), the host link has none.
+ */
+uint16 UART_getHwOverrunCount(void)
+{
+	return 0;
+}
+
+/*
+ * Description :
+ * Set the call-back function called from the poll function after a byte is put in the RX buffer.
+ * Only used in interrupt mode.
+ */
+void UART_setRxCallBack(void(*a_ptr)(void))
+{
+	g_UART_RxCallBack = a_ptr;
+}
+
+/*
+ * Description :
+ * Send the required string through UART to the other UART device.
+ */
+void UART_sendString(const uint8 *Str)
+{
+	uint8 i = 0;
+
+	while(Str[i] != '\0')
+	{
+		UART_sendByte(Str[i]);
+		i++;
+	}
+}
+
+/*
+ * Description :
+ * Receive the required string until the '#' symbol through UART from the other UART device.
+ */
+void UART_receiveString(uint8 *Str)
+{
+	uint8 i = 0;
+
+	Str[i] = UART_recieveByte();
+	while(Str[i] != '#')
+	{
+		i++;
+		Str[i] = UART_recieveByte();
+	}
+	Str[i] = '\0';
+}
+
+static void UART_poll(void)
+{
+	uint8 data;
+	uint8 next_head;
+
+	while (Host_linkRead(&data))
+	{
+		next_head = (g_rxHead + 1) & UART_RX_BUFFER_MASK;
+
+		if (next_head == g_rxTail)
+		{
+			/* RX buffer is full, the byte is dropped */
+			g_rxOverrunCount++;
+			continue;
+		}
+		g_rxBuffer[g_rxHead] = data;
+		g_rxHead = next_head;
+
+		if (g_uartMode == UART_INTERRUPT_MODE && g_UART_RxCallBack != NULL_PTR)
+		{
+			(*g_UART_RxCallBack)();
+		}
+	}
+}
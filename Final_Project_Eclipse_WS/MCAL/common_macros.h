@@ -34,4 +34,7 @@
 /* Check if a specific bit is cleared in any register and return true if yes */
 #define BIT_IS_CLEAR(REG,BIT) ( !(REG & (1<<BIT)) )
 
+/* Get the value of a specific bit in any register, 0 or 1 */
+#define GET_BIT(REG,BIT) ( ( REG & (1<<BIT) ) >> BIT )
+
 #endif
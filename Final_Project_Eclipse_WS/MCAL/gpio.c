@@ -290,6 +290,44 @@ void GPIO_writePort(uint8 port_num, uint8 value)
 	}
 }
 
+/*
+ * Description :
+ * Write the bits of the value selected by the mask on the required port, the other pins keep their value.
+ * All the selected pins change together in one register write.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num, uint8 mask, uint8 value)
+{
+	/*
+	 * Check if the input number is greater than NUM_OF_PORTS value.
+	 * In this case the input is not valid port number
+	 */
+	if(port_num >= NUM_OF_PORTS)
+	{
+		/* Do Nothing */
+	}
+	else
+	{
+		/* Keep the pins out of the mask and write the others */
+		value &= mask;
+		switch(port_num)
+		{
+		case PORTA_ID:
+			PORTA = (PORTA & ~mask) | value;
+			break;
+		case PORTB_ID:
+			PORTB = (PORTB & ~mask) | value;
+			break;
+		case PORTC_ID:
+			PORTC = (PORTC & ~mask) | value;
+			break;
+		case PORTD_ID:
+			PORTD = (PORTD & ~mask) | value;
+			break;
+		}
+	}
+}
+
 /*
  * Description :
  * Read and return the value of the required port.
@@ -81,7 +81,7 @@ uint8 GPIO_readPin(uint8 port_num, uint8 pin_num);
  * If the direction value is PORT_OUTPUT all pins in this port should be output pins.
  * If the input port number is not correct, The function will not handle the request.
  */
-void GPIO_setupPortDirection(uint8 port_num, uint8 direction);
+void GPIO_setupPortDirection(uint8 port_num, GPIO_PortDirectionType direction);
 
 /*
  * Description :
@@ -92,6 +92,14 @@ void GPIO_setupPortDirection(uint8 port_num, uint8 direction);
  */
 void GPIO_writePort(uint8 port_num, uint8 value);
 
+/*
+ * Description :
+ * Write the bits of the value selected by the mask on the required port, the other pins keep their value.
+ * All the selected pins change together in one register write.
+ * If the input port number is not correct, The function will not handle the request.
+ */
+void GPIO_writePortMasked(uint8 port_num, uint8 mask, uint8 value);
+
 /*
  * Description :
  * Read and return the value of the required port.
@@ -99,4 +107,70 @@ void GPIO_writePort(uint8 port_num, uint8 value);
  */
 uint8 GPIO_readPort(uint8 port_num);
 
+/*******************************************************************************
+ *                          Compile-time Pin Access                            *
+ *******************************************************************************/
+
+/*
+ * Macros of the pin and port functions for port and pin numbers known at compile time,
+ * without the range checks and the switch on the port number of the functions.
+ * The optimized builds turn the pin macros into a single sbi/cbi instruction,
+ * and GPIO_READ_PIN in a condition into sbis/sbic.
+ * Use the functions above for port and pin numbers known at run time only.
+ *
+ * The host build has no registers, the macros call the functions instead.
+ */
+#ifdef __AVR__
+
+#include <avr/io.h>
+
+/* The registers of port x are PINx, DDRx then PORTx, the next port is 3 addresses lower */
+#define GPIO_PIN_REGISTER(port_num)    (*(&PINA - 3 * (port_num)))
+#define GPIO_DDR_REGISTER(port_num)    (*(&DDRA - 3 * (port_num)))
+#define GPIO_PORT_REGISTER(port_num)   (*(&PORTA - 3 * (port_num)))
+
+#define GPIO_SETUP_PIN_DIRECTION(port_num,pin_num,direction) \
+	do { \
+		if((direction) == PIN_OUTPUT) \
+			GPIO_DDR_REGISTER(port_num) |= (1 << (pin_num)); \
+		else \
+			GPIO_DDR_REGISTER(port_num) &= ~(1 << (pin_num)); \
+	} while(0)
+
+#define GPIO_WRITE_PIN(port_num,pin_num,value) \
+	do { \
+		if((value) == LOGIC_HIGH) \
+			GPIO_PORT_REGISTER(port_num) |= (1 << (pin_num)); \
+		else \
+			GPIO_PORT_REGISTER(port_num) &= ~(1 << (pin_num)); \
+	} while(0)
+
+#define GPIO_READ_PIN(port_num,pin_num) \
+	((GPIO_PIN_REGISTER(port_num) & (1 << (pin_num))) ? LOGIC_HIGH : LOGIC_LOW)
+
+#define GPIO_SETUP_PORT_DIRECTION(port_num,direction)   (GPIO_DDR_REGISTER(port_num) = (direction))
+#define GPIO_WRITE_PORT(port_num,value)                 (GPIO_PORT_REGISTER(port_num) = (value))
+#define GPIO_WRITE_PORT_MASKED(port_num,mask,value) \
+	(GPIO_PORT_REGISTER(port_num) = (GPIO_PORT_REGISTER(port_num) & ~(mask)) | ((value) & (mask)))
+#define GPIO_READ_PORT(port_num)                        (GPIO_PIN_REGISTER(port_num))
+
+/*
+ * An input pin is read through a synchronizer, a pin driven by the previous
+ * instruction is seen one cycle later. Wait that cycle before reading it back.
+ */
+#define GPIO_SYNC()   __asm__ __volatile__ ("nop")
+
+#else
+
+#define GPIO_SETUP_PIN_DIRECTION(port_num,pin_num,direction)   GPIO_setupPinDirection(port_num,pin_num,direction)
+#define GPIO_WRITE_PIN(port_num,pin_num,value)                 GPIO_writePin(port_num,pin_num,value)
+#define GPIO_READ_PIN(port_num,pin_num)                        GPIO_readPin(port_num,pin_num)
+#define GPIO_SETUP_PORT_DIRECTION(port_num,direction)          GPIO_setupPortDirection(port_num,direction)
+#define GPIO_WRITE_PORT(port_num,value)                        GPIO_writePort(port_num,value)
+#define GPIO_WRITE_PORT_MASKED(port_num,mask,value)           GPIO_writePortMasked(port_num,mask,value)
+#define GPIO_READ_PORT(port_num)                               GPIO_readPort(port_num)
+#define GPIO_SYNC()                                            ((void)0)
+
+#endif
+
 #endif /* GPIO_H_ */
@@ -0,0 +1,752 @@
+/***************************************************************************
+ *
+ * Module Name: LCD
+ * 	 
+ * File Name: lcd.c
+ *
+ * Description: Source file for LCD Driver
+ *
+ * Created on: Oct 7, 2022
+ *
+ * Author: Omar EL-Sheikh
+ * 
+ **************************************************************************/
+
+/*******************************************************************************
+ *                      Inclusions
+ *******************************************************************************/
+#include <util/delay.h> /* For the delay functions */
+#include <stdlib.h> /* For itoa function */
+#include <avr/pgmspace.h> /* For the strings in flash */
+#include "common_macros.h" /* For GET_BIT Macro */
+#include "lcd.h"
+#include "gpio.h"
+
+/*******************************************************************************
+ *                      Definitions                                            *
+ *******************************************************************************/
+#define LCD_ASYNC_QUEUE_MASK (LCD_ASYNC_QUEUE_SIZE - 1)
+
+/*******************************************************************************
+ *                      Types Declarations                                     *
+ *******************************************************************************/
+
+/* Structure to hold one queued write */
+typedef struct {
+ uint8 rs;     /* LOGIC_LOW for an instruction, LOGIC_HIGH for data */
+ uint8 value;
+} LCD_QueueEntryType;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* TRUE if the last instruction was clear or return home, which take much longer */
+static boolean g_longInstruction = FALSE;
+
+#if(LCD_BUSY_FLAG_MODE == 1)
+/* The busy flag can not be read before the interface width is set, nor after a polling timeout */
+static boolean g_busyFlagValid = FALSE;
+
+/* Time source of the polling timeout */
+static uint32 (*g_timeCallBack_Ptr)(void) = NULL_PTR;
+#endif
+
+/* DDRAM address of the LCD cursor, updated by every instruction and data write */
+static uint8 g_lcdAddress = 0;
+
+/* Shadow copy of the screen and its cursor */
+static uint8 g_buffer[LCD_ROWS][LCD_COLS];
+static uint8 g_bufferRow = 0;
+static uint8 g_bufferCol = 0;
+
+/* Bit (col) of each row is set if the character is not on the screen yet */
+static uint16 g_dirtyCells[LCD_ROWS];
+
+/*
+ * Writes waiting for LCD_processQueue, filled by the application and emptied from an ISR
+ * The entries are volatile too, so an entry is written before the tail that publishes it
+ */
+static volatile LCD_QueueEntryType g_queue[LCD_ASYNC_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Return the DDRAM address of a specified row and column index
+ */
+static uint8 LCD_getAddress(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Wait until the LCD can accept the next instruction or data
+ */
+static void LCD_waitReady(void);
+
+/*
+ * Description :
+ * Update the tracked DDRAM address after a write
+ */
+static void LCD_trackAddress(uint8 rs, uint8 value);
+
+/*
+ * Description :
+ * Add a write to the queue, wait for a free place if the queue is full
+ */
+static void LCD_queueWrite(uint8 rs, uint8 value);
+
+/*
+ * Description :
+ * Write an instruction (RS = LOGIC_LOW) or data (RS = LOGIC_HIGH) to the LCD
+ */
+static void LCD_write(uint8 rs, uint8 value);
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Description :
+ * Latch the lower 4 bits of the given value on DB4 --> DB7
+ */
+static void LCD_writeNibble(uint8 nibble);
+#endif
+
+#if(LCD_BUSY_FLAG_MODE == 1)
+/*
+ * Description :
+ * Read the LCD busy flag over the R/W line
+ */
+static uint8 LCD_readBusyFlag(void);
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ */
+void LCD_init(void)
+{
+	uint8 row,col;
+
+	/* The screen is cleared at the end of the initialization, so is the shadow buffer */
+	for(row = 0; row < LCD_ROWS; row++)
+	{
+		for(col = 0; col < LCD_COLS; col++)
+		{
+			g_buffer[row][col] = ' ';
+		}
+		g_dirtyCells[row] = 0;
+	}
+	g_bufferRow = 0;
+	g_bufferCol = 0;
+
+	/* Configure the direction for RS and E pins as output pins */
+	GPIO_SETUP_PIN_DIRECTION(LCD_RS_PORT_ID,LCD_RS_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_E_PORT_ID,LCD_E_PIN_ID,PIN_OUTPUT);
+
+#if(LCD_BUSY_FLAG_MODE == 1)
+	/* Configure the R/W pin as output pin, writing by default */
+	GPIO_SETUP_PIN_DIRECTION(LCD_RW_PORT_ID,LCD_RW_PIN_ID,PIN_OUTPUT);
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW);
+	g_busyFlagValid = FALSE;
+#endif
+
+	_delay_ms(20);		/* LCD Power ON delay always > 15ms */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	/* Configure 4 pins in the data port as output pins */
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_OUTPUT);
+
+	/* Send for 4 bit initialization of LCD, the LCD is still in 8-bits mode so only the high nibble is read */
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	LCD_writeNibble(0X03);
+	_delay_us(LCD_RESET_FIRST_TIME_US);
+	LCD_writeNibble(0X03);
+	_delay_us(LCD_RESET_TIME_US);
+	LCD_writeNibble(0X03);
+	_delay_us(LCD_RESET_TIME_US);
+	LCD_writeNibble(0X02);
+	_delay_us(LCD_INSTRUCTION_TIME_US);
+
+	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
+	LCD_sendCommand(LCD_TWO_LINES_FOUR_BITS_MODE);
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	/* Configure the data port as output port */
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+
+	/* use 2-lines LCD + 8-bits Data Mode + 5*7 dot display Mode */
+	LCD_sendCommand(LCD_TWO_LINES_EIGHT_BITS_MODE);
+
+#endif
+
+#if(LCD_BUSY_FLAG_MODE == 1)
+	/* The interface width is set, the next instructions can poll the busy flag if the polling can be timed */
+	LCD_waitReady();
+	g_busyFlagValid = (g_timeCallBack_Ptr != NULL_PTR) ? TRUE : FALSE;
+#endif
+
+	LCD_sendCommand(LCD_CURSOR_OFF); /* cursor off */
+	LCD_sendCommand(LCD_CLEAR_COMMAND); /* clear LCD at the beginning */
+}
+
+/*
+ * Description :
+ * Set the function returning the time in micro-seconds, to time the busy flag polling
+ */
+void LCD_setTimeCallBack(uint32 (*a_ptr)(void))
+{
+#if(LCD_BUSY_FLAG_MODE == 1)
+	g_timeCallBack_Ptr = a_ptr;
+#else
+	(void)a_ptr; /* The execution times are always waited */
+#endif
+}
+
+/*
+ * Description :
+ * Send the required command to the screen
+ */
+void LCD_sendCommand(uint8 command)
+{
+	LCD_write(LOGIC_LOW,command); /* Instruction Mode RS=0 */
+	LCD_trackAddress(LOGIC_LOW,command);
+}
+
+/*
+ * Description :
+ * Display the required character on the screen
+ */
+void LCD_displayCharacter(uint8 data)
+{
+	LCD_write(LOGIC_HIGH,data); /* Data Mode RS=1 */
+	LCD_trackAddress(LOGIC_HIGH,data);
+}
+
+/*
+ * Description :
+ * Queue the required command to be sent by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_sendCommandAsync(uint8 command)
+{
+	LCD_queueWrite(LOGIC_LOW,command); /* Instruction Mode RS=0 */
+	LCD_trackAddress(LOGIC_LOW,command);
+}
+
+/*
+ * Description :
+ * Queue the required character to be displayed by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_displayCharacterAsync(uint8 data)
+{
+	LCD_queueWrite(LOGIC_HIGH,data); /* Data Mode RS=1 */
+	LCD_trackAddress(LOGIC_HIGH,data);
+}
+
+/*
+ * Description :
+ * Queue the required string to be displayed by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_displayStringAsync(const char *Str)
+{
+	while((*Str) != '\0')
+	{
+		LCD_displayCharacterAsync(*Str);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Wait until LCD_processQueue has sent everything in the queue
+ */
+void LCD_flush(void)
+{
+	while(g_queueHead != g_queueTail){}
+}
+
+/*
+ * Description :
+ * Send up to LCD_ASYNC_WRITES_PER_CALL queued writes to the LCD
+ * Should be called periodically from a timer ISR with a period longer than LCD_CLEAR_TIME_US
+ */
+void LCD_processQueue(void)
+{
+	uint8 writes;
+
+	/* The last instruction had a whole period to execute, even clear display */
+	g_longInstruction = FALSE;
+
+	for(writes = 0; (writes < LCD_ASYNC_WRITES_PER_CALL) && (g_queueHead != g_queueTail); writes++)
+	{
+		LCD_write(g_queue[g_queueHead].rs,g_queue[g_queueHead].value);
+		g_queueHead = (g_queueHead + 1) & LCD_ASYNC_QUEUE_MASK;
+
+		/* Leave a slow instruction to the next period instead of waiting for it here */
+		if(g_longInstruction)
+		{
+			break;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Update the tracked DDRAM address after a write
+ */
+static void LCD_trackAddress(uint8 rs, uint8 value)
+{
+	/* Keep track of the cursor so LCD_refresh can skip useless cursor moves */
+	if(rs == LOGIC_HIGH)
+	{
+		g_lcdAddress++;
+	}
+	else if(value & LCD_SET_CURSOR_LOCATION)
+	{
+		g_lcdAddress = value & ~LCD_SET_CURSOR_LOCATION;
+	}
+	else if(value <= (LCD_GO_TO_HOME | 0X01))
+	{
+		g_lcdAddress = 0;
+	}
+}
+
+/*
+ * Description :
+ * Add a write to the queue, wait for a free place if the queue is full
+ */
+static void LCD_queueWrite(uint8 rs, uint8 value)
+{
+	uint8 next_tail = (g_queueTail + 1) & LCD_ASYNC_QUEUE_MASK;
+
+	/* LCD_processQueue frees a place on its next call */
+	while(next_tail == g_queueHead){}
+
+	g_queue[g_queueTail].rs = rs;
+	g_queue[g_queueTail].value = value;
+	g_queueTail = next_tail;
+}
+
+/*
+ * Description :
+ * Wait until the LCD can accept the next instruction or data
+ * The wait is done before each write, so the CPU is free while the LCD executes the last one
+ */
+static void LCD_waitReady(void)
+{
+#if(LCD_BUSY_FLAG_MODE == 1)
+	uint32 start_time;
+
+	if(g_busyFlagValid)
+	{
+		start_time = (*g_timeCallBack_Ptr)();
+		while(LCD_readBusyFlag() == LOGIC_HIGH)
+		{
+			if(((*g_timeCallBack_Ptr)() - start_time) > LCD_BUSY_TIMEOUT_US)
+			{
+				/* The R/W line does not answer, the execution times are waited from now on */
+				g_busyFlagValid = FALSE;
+				break;
+			}
+		}
+		return;
+	}
+#endif
+
+	/* Fixed execution times when the busy flag can not be read */
+	if(g_longInstruction)
+	{
+		_delay_us(LCD_CLEAR_TIME_US);
+	}
+	else
+	{
+		_delay_us(LCD_INSTRUCTION_TIME_US);
+	}
+}
+
+/*
+ * Description :
+ * Write an instruction (RS = LOGIC_LOW) or data (RS = LOGIC_HIGH) to the LCD
+ */
+static void LCD_write(uint8 rs, uint8 value)
+{
+	LCD_waitReady();
+
+	/* Clear display (0x01) and return home (0x02, 0x03) take 1.52 ms instead of 37 us */
+	g_longInstruction = ((rs == LOGIC_LOW) && (value <= (LCD_GO_TO_HOME | 0X01))) ? TRUE : FALSE;
+
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,rs);
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	LCD_writeNibble(value >> 4); /* high nibble first */
+	LCD_writeNibble(value);
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+	GPIO_WRITE_PORT(LCD_DATA_PORT_ID,value); /* out the required value to the data bus D0 --> D7 */
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns */
+#endif
+}
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Description :
+ * Latch the lower 4 bits of the given value on DB4 --> DB7
+ */
+static void LCD_writeNibble(uint8 nibble)
+{
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tpw - Tdws = 190ns */
+
+#if(LCD_NIBBLE_PORT_WRITE == 1)
+	/* All the data lines change in one register write */
+	GPIO_WRITE_PORT_MASKED(LCD_DATA_PORT_ID,LCD_DATA_NIBBLE_MASK,(uint8)(nibble << LCD_DB4_PIN_ID));
+#else
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(nibble,0));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(nibble,1));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(nibble,2));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(nibble,3));
+#endif
+
+	_delay_us(1); /* delay for processing Tdsw = 100ns */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 13ns and the 1us enable cycle time */
+}
+#endif
+
+#if(LCD_BUSY_FLAG_MODE == 1)
+/*
+ * Description :
+ * Read the LCD busy flag over the R/W line
+ */
+static uint8 LCD_readBusyFlag(void)
+{
+	uint8 busy_flag;
+
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_HIGH); /* Read Mode R/W=1 */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_INPUT);
+
+	/* The last data written would turn the pull-ups on, a missing LCD must not read as busy */
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,LOGIC_LOW);
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,LOGIC_LOW);
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,LOGIC_LOW);
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,LOGIC_LOW);
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+	/* The busy flag is DB7 of the high nibble */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tddr = 160ns */
+	busy_flag = GPIO_READ_PIN(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID);
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1);
+
+	/* The low nibble must be clocked out too */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1);
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1);
+
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_OUTPUT);
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_INPUT);
+	GPIO_WRITE_PORT(LCD_DATA_PORT_ID,0X00); /* Pull-ups off, the last data written would turn them on */
+	_delay_us(1); /* delay for processing Tas = 50ns */
+
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	_delay_us(1); /* delay for processing Tddr = 160ns */
+	busy_flag = GPIO_READ_PIN(LCD_DATA_PORT_ID,PIN7_ID); /* The busy flag is DB7 */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1);
+
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+#endif
+
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW); /* Back to Write Mode R/W=0 */
+	return busy_flag;
+}
+#endif
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str)
+{
+	uint8 i = 0;
+	while(Str[i] != '\0')
+	{
+		LCD_displayCharacter(Str[i]);
+		i++;
+	}
+	/***************** Another Method ***********************
+	while((*Str) != '\0')
+	{
+		LCD_displayCharacter(*Str);
+		Str++;
+	}
+	*********************************************************/
+}
+
+/*
+ * Description :
+ * Display the required string stored in flash on the screen
+ */
+void LCD_displayString_P(const char *Str)
+{
+	uint8 data;
+
+	while((data = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_displayCharacter(data);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen
+ */
+void LCD_moveCursor(uint8 row,uint8 col)
+{
+	/* Move the LCD cursor to this specific address */
+	LCD_sendCommand(LCD_getAddress(row,col) | LCD_SET_CURSOR_LOCATION);
+}
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString(Str); /* display the string */
+}
+
+/*
+ * Description :
+ * Display the required string stored in flash in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col);
+	LCD_displayString_P(Str);
+}
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data)
+{
+   char buff[16]; /* String to hold the ascii result */
+   itoa(data,buff,10); /* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
+   LCD_displayString(buff); /* Display the string */
+}
+
+/*
+ * Description :
+ * Send the clear screen command
+ */
+void LCD_clearScreen(void)
+{
+	LCD_sendCommand(LCD_CLEAR_COMMAND); /* Send clear display command */
+}
+
+/*
+ * Description :
+ * Fill the shadow buffer with spaces, the screen is cleared by the next LCD_refresh
+ */
+void LCD_bufferClear(void)
+{
+	uint8 row,col;
+
+	for(row = 0; row < LCD_ROWS; row++)
+	{
+		for(col = 0; col < LCD_COLS; col++)
+		{
+			if(g_buffer[row][col] != ' ')
+			{
+				g_buffer[row][col] = ' ';
+				g_dirtyCells[row] |= (1U << col);
+			}
+		}
+	}
+	g_bufferRow = 0;
+	g_bufferCol = 0;
+}
+
+/*
+ * Description :
+ * Move the shadow buffer cursor to a specified row and column index
+ */
+void LCD_bufferMoveCursor(uint8 row,uint8 col)
+{
+	g_bufferRow = row;
+	g_bufferCol = col;
+}
+
+/*
+ * Description :
+ * Write the required character in the shadow buffer at the cursor and advance the cursor
+ * Characters after the end of the row are dropped
+ */
+void LCD_bufferDisplayCharacter(uint8 data)
+{
+	if((g_bufferRow < LCD_ROWS) && (g_bufferCol < LCD_COLS))
+	{
+		/* Only a different character has to be sent to the screen */
+		if(g_buffer[g_bufferRow][g_bufferCol] != data)
+		{
+			g_buffer[g_bufferRow][g_bufferCol] = data;
+			g_dirtyCells[g_bufferRow] |= (1U << g_bufferCol);
+		}
+		g_bufferCol++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string in the shadow buffer at the cursor
+ */
+void LCD_bufferDisplayString(const char *Str)
+{
+	while((*Str) != '\0')
+	{
+		LCD_bufferDisplayCharacter(*Str);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string in the shadow buffer at a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_bufferMoveCursor(row,col);
+	LCD_bufferDisplayString(Str);
+}
+
+/*
+ * Description :
+ * Write the required string stored in flash in the shadow buffer at the cursor
+ */
+void LCD_bufferDisplayString_P(const char *Str)
+{
+	uint8 data;
+
+	while((data = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_bufferDisplayCharacter(data);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Write the required string stored in flash in the shadow buffer at a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_bufferMoveCursor(row,col);
+	LCD_bufferDisplayString_P(Str);
+}
+
+/*
+ * Description :
+ * Write the required decimal value in the shadow buffer at the cursor
+ */
+void LCD_bufferIntgerToString(int data)
+{
+	char buff[16]; /* String to hold the ascii result */
+	itoa(data,buff,10); /* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
+	LCD_bufferDisplayString(buff);
+}
+
+/*
+ * Description :
+ * Queue the changed characters of the shadow buffer to be sent by LCD_processQueue
+ * Consecutive changed characters in a row need one cursor move only
+ */
+void LCD_refresh(void)
+{
+	uint8 row,col;
+	uint8 address;
+
+	for(row = 0; row < LCD_ROWS; row++)
+	{
+		if(g_dirtyCells[row] == 0)
+		{
+			continue;
+		}
+
+		for(col = 0; col < LCD_COLS; col++)
+		{
+			if(g_dirtyCells[row] & (1U << col))
+			{
+				/* The LCD moves its cursor after each character, so a move is only needed after a gap */
+				address = LCD_getAddress(row,col);
+				if(address != g_lcdAddress)
+				{
+					LCD_sendCommandAsync(address | LCD_SET_CURSOR_LOCATION);
+				}
+				LCD_displayCharacterAsync(g_buffer[row][col]);
+			}
+		}
+		g_dirtyCells[row] = 0;
+	}
+}
+
+/*
+ * Description :
+ * Return the DDRAM address of a specified row and column index
+ */
+static uint8 LCD_getAddress(uint8 row,uint8 col)
+{
+	uint8 lcd_memory_address = col;
+
+	/* Calculate the required address in the LCD DDRAM */
+	switch(row)
+	{
+		case 0:
+			lcd_memory_address=col;
+				break;
+		case 1:
+			lcd_memory_address=col+0x40;
+				break;
+		case 2:
+			lcd_memory_address=col+0x10;
+				break;
+		case 3:
+			lcd_memory_address=col+0x50;
+				break;
+	}
+	return lcd_memory_address;
+}
@@ -0,0 +1,289 @@
+/***************************************************************************
+ *
+ * Module Name: LCD
+ * 	 
+ * File Name: lcd.h
+ *
+ * Description: Header file for LCD Driver
+ *
+ * Created on: Oct 7, 2022
+ *
+ * Author: Omar EL-Sheikh
+ * 
+ **************************************************************************/
+#ifndef LCD_H_
+#define LCD_H_
+
+#include "std_types.h"
+#include "lcd_cfg.h" /* LCD board configuration of the ECU */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * The board configuration lcd_cfg.h of every ECU gives:
+ * LCD_DATA_BITS_MODE, LCD_ROWS, LCD_COLS, LCD_BUSY_FLAG_MODE and the LCD HW Ports and Pins Ids.
+ */
+
+#if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
+
+#error "Number of Data bits should be equal to 4 or 8"
+
+#endif
+
+#if((LCD_ROWS > 4) || (LCD_COLS > 16))
+
+#error "LCD shadow buffer supports up to 4 rows of 16 columns"
+
+#endif
+
+#if((LCD_BUSY_FLAG_MODE != 0) && (LCD_BUSY_FLAG_MODE != 1))
+
+#error "LCD busy flag mode should be equal to 0 or 1"
+
+#endif
+
+/*
+ * 4-bits data write configuration, its value should be 0 or 1
+ * 1: DB4 --> DB7 are written together by one masked port write, they should be consecutive pins
+ * 0: DB4 --> DB7 are written one pin at a time
+ */
+#ifndef LCD_NIBBLE_PORT_WRITE
+#define LCD_NIBBLE_PORT_WRITE 1
+#endif
+
+#if((LCD_NIBBLE_PORT_WRITE != 0) && (LCD_NIBBLE_PORT_WRITE != 1))
+
+#error "LCD nibble port write should be equal to 0 or 1"
+
+#endif
+
+#if((LCD_DATA_BITS_MODE == 4) && (LCD_NIBBLE_PORT_WRITE == 1))
+
+#if((LCD_DB5_PIN_ID != LCD_DB4_PIN_ID + 1) || (LCD_DB6_PIN_ID != LCD_DB4_PIN_ID + 2) || (LCD_DB7_PIN_ID != LCD_DB4_PIN_ID + 3))
+
+#error "LCD nibble port write needs DB4 --> DB7 on consecutive pins"
+
+#endif
+
+/* Pins of DB4 --> DB7 in the data port */
+#define LCD_DATA_NIBBLE_MASK           (0X0F << LCD_DB4_PIN_ID)
+
+#endif
+
+/* HD44780 execution times in micro-seconds at 270 KHz (37us and 1.52ms) rounded up */
+#define LCD_INSTRUCTION_TIME_US        40
+#define LCD_CLEAR_TIME_US              1600
+
+/* Waits of the 4-bits initialization sequence */
+#define LCD_RESET_FIRST_TIME_US        4100
+#define LCD_RESET_TIME_US              100
+
+/* Longest busy flag polling, after it the R/W line is taken as not answering and the execution times are waited */
+#define LCD_BUSY_TIMEOUT_US            2000
+
+/* Asynchronous writes queue size, should be a power of two up to 256 */
+#define LCD_ASYNC_QUEUE_SIZE           64
+
+/* Queued writes sent on each LCD_processQueue call */
+#define LCD_ASYNC_WRITES_PER_CALL      8
+
+#if((LCD_ASYNC_QUEUE_SIZE & (LCD_ASYNC_QUEUE_SIZE - 1)) != 0) || (LCD_ASYNC_QUEUE_SIZE > 256)
+
+#error "LCD asynchronous queue size should be a power of two not greater than 256"
+
+#endif
+
+/* LCD Commands */
+#define LCD_CLEAR_COMMAND                    0x01
+#define LCD_GO_TO_HOME                       0x02
+#define LCD_TWO_LINES_EIGHT_BITS_MODE        0x38
+#define LCD_TWO_LINES_FOUR_BITS_MODE         0x28
+#define LCD_CURSOR_OFF                       0x0C
+#define LCD_CURSOR_ON                        0x0E
+#define LCD_SET_CURSOR_LOCATION              0x80
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ */
+void LCD_init(void);
+
+/*
+ * Description :
+ * Set the function returning the time in micro-seconds, like SoftTimer_getTimeUs, to time the busy flag polling
+ * It should be called before LCD_init, without it the busy flag is not polled and the execution times are waited
+ */
+void LCD_setTimeCallBack(uint32 (*a_ptr)(void));
+
+/*
+ * Description :
+ * Send the required command to the screen
+ */
+void LCD_sendCommand(uint8 command);
+
+/*
+ * Description :
+ * Display the required character on the screen
+ */
+void LCD_displayCharacter(uint8 data);
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str);
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen
+ */
+void LCD_moveCursor(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Functions ending with _P take a string stored in flash (PROGMEM or PSTR),
+ * so the string is not copied into SRAM at startup.
+ */
+
+/*
+ * Description :
+ * Display the required string stored in flash on the screen
+ */
+void LCD_displayString_P(const char *Str);
+
+/*
+ * Description :
+ * Display the required string stored in flash in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data);
+
+/*
+ * Description :
+ * Send the clear screen command
+ */
+void LCD_clearScreen(void);
+
+/*
+ * Asynchronous functions:
+ * Writes are queued and sent by LCD_processQueue, which should be called periodically
+ * from a timer ISR, so the application does not wait for the LCD.
+ * Call LCD_flush before using the direct functions again.
+ */
+
+/*
+ * Description :
+ * Queue the required command to be sent by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_sendCommandAsync(uint8 command);
+
+/*
+ * Description :
+ * Queue the required character to be displayed by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_displayCharacterAsync(uint8 data);
+
+/*
+ * Description :
+ * Queue the required string to be displayed by LCD_processQueue
+ * Wait for a free place if the queue is full
+ */
+void LCD_displayStringAsync(const char *Str);
+
+/*
+ * Description :
+ * Wait until LCD_processQueue has sent everything in the queue
+ */
+void LCD_flush(void);
+
+/*
+ * Description :
+ * Send up to LCD_ASYNC_WRITES_PER_CALL queued writes to the LCD
+ * Should be called periodically from a timer ISR with a period longer than LCD_CLEAR_TIME_US
+ */
+void LCD_processQueue(void);
+
+/*
+ * Shadow buffer functions:
+ * The application writes into a copy of the screen kept in SRAM and calls LCD_refresh
+ * to send only the characters that changed. Writing the same text again costs nothing.
+ * The direct functions above bypass the buffer, an application should use one set only.
+ */
+
+/*
+ * Description :
+ * Fill the shadow buffer with spaces, the screen is cleared by the next LCD_refresh
+ */
+void LCD_bufferClear(void);
+
+/*
+ * Description :
+ * Move the shadow buffer cursor to a specified row and column index
+ */
+void LCD_bufferMoveCursor(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Write the required character in the shadow buffer at the cursor and advance the cursor
+ * Characters after the end of the row are dropped
+ */
+void LCD_bufferDisplayCharacter(uint8 data);
+
+/*
+ * Description :
+ * Write the required string in the shadow buffer at the cursor
+ */
+void LCD_bufferDisplayString(const char *Str);
+
+/*
+ * Description :
+ * Write the required string in the shadow buffer at a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Write the required string stored in flash in the shadow buffer at the cursor
+ */
+void LCD_bufferDisplayString_P(const char *Str);
+
+/*
+ * Description :
+ * Write the required string stored in flash in the shadow buffer at a specified row and column index
+ */
+void LCD_bufferDisplayStringRowColumn_P(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Write the required decimal value in the shadow buffer at the cursor
+ */
+void LCD_bufferIntgerToString(int data);
+
+/*
+ * Description :
+ * Queue the changed characters of the shadow buffer to be sent by LCD_processQueue
+ * Consecutive changed characters in a row need one cursor move only
+ */
+void LCD_refresh(void);
+
+#endif /* LCD_H_ */
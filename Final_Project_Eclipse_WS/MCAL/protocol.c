@@ -0,0 +1,243 @@
+/***************************************************************************
+ *
+ * Module Name: PROTOCOL
+ *
+ * File Name: protocol.c
+ *
+ * Description: Source file for the HMI ECU <-> CONTROL ECU Message Protocol
+ *
+ * Created on: Nov 12, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "protocol.h"
+#include "uart.h"
+
+/*******************************************************************************
+ *                                Types Declarations                          *
+ *******************************************************************************/
+
+/* Enumeration Constants for the frame parser states */
+typedef enum {
+	WAIT_START, WAIT_LENGTH, WAIT_TYPE, WAIT_PAYLOAD, WAIT_CRC
+} Protocol_ParserState;
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Frame parser state, kept between calls so frames can arrive in pieces */
+static Protocol_ParserState g_parserState = WAIT_START;
+static uint8 g_parserIndex = 0;
+static uint8 g_parserCrc = 0;
+static Protocol_FrameType g_parserFrame;
+
+/* Link statistics */
+static Protocol_StatsType g_stats = {0, 0, 0, 0};
+
+/* Payload size of every message type, indexed from PROTOCOL_MSG_OPTION */
+static const uint8 g_payloadSize[] = {
+	PROTOCOL_OPTION_PAYLOAD_SIZE,
+	PROTOCOL_PASSWORD_PAYLOAD_SIZE,
+	PROTOCOL_NEW_PASSWORD_PAYLOAD_SIZE,
+	PROTOCOL_VERIFY_RESULT_PAYLOAD_SIZE,
+	PROTOCOL_DOOR_STATE_PAYLOAD_SIZE
+};
+
+#define PROTOCOL_MESSAGE_TYPES (sizeof(g_payloadSize) / sizeof(g_payloadSize[0]))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Update the running CRC-8 with one byte.
+ */
+static uint8 Protocol_crc8Update(uint8 crc, uint8 data);
+
+/*
+ * Description :
+ * Feed one received byte to the frame parser.
+ * Returns TRUE when the byte completes a frame with a correct CRC.
+ */
+static boolean Protocol_processByte(uint8 data, Protocol_FrameType *frame_Ptr);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Build a frame around the given payload and send it through UART.
+ * Payloads longer than PROTOCOL_MAX_PAYLOAD_SIZE are not sent.
+ */
+void Protocol_sendFrame(Protocol_MessageType type, const uint8 *payload_Ptr, uint8 length)
+{
+	uint8 i;
+	uint8 crc = 0;
+
+	if (length > PROTOCOL_MAX_PAYLOAD_SIZE)
+	{
+		return;
+	}
+
+	UART_sendByte(PROTOCOL_START_OF_FRAME);
+
+	UART_sendByte(length);
+	crc = Protocol_crc8Update(crc, length);
+
+	UART_sendByte(type);
+	crc = Protocol_crc8Update(crc, type);
+
+	for (i = 0; i < length; i++)
+	{
+		UART_sendByte(payload_Ptr[i]);
+		crc = Protocol_crc8Update(crc, payload_Ptr[i]);
+	}
+
+	UART_sendByte(crc);
+	g_stats.frames_sent++;
+}
+
+/*
+ * Description :
+ * Wait until a complete frame with a correct CRC is received.
+ */
+void Protocol_receiveFrame(Protocol_FrameType *frame_Ptr)
+{
+	while (!Protocol_processByte(UART_recieveByte(), frame_Ptr)){}
+}
+
+/*
+ * Description :
+ * Parse the bytes already received by UART without waiting.
+ * Returns TRUE when a complete frame with a correct CRC is stored in frame_Ptr.
+ */
+boolean Protocol_tryReceiveFrame(Protocol_FrameType *frame_Ptr)
+{
+	uint8 data;
+
+	while (UART_tryReceive(&data))
+	{
+		if (Protocol_processByte(data, frame_Ptr))
+		{
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Copy the link statistics counters.
+ */
+void Protocol_getStats(Protocol_StatsType *stats_Ptr)
+{
+	*stats_Ptr = g_stats;
+}
+
+/*
+ * Description :
+ * Update the running CRC-8 with one byte.
+ */
+static uint8 Protocol_crc8Update(uint8 crc, uint8 data)
+{
+	uint8 bit;
+
+	crc ^= data;
+	for (bit = 0; bit < 8; bit++)
+	{
+		if (crc & 0X80)
+		{
+			crc = (crc << 1) ^ PROTOCOL_CRC8_POLYNOMIAL;
+		}
+		else
+		{
+			crc <<= 1;
+		}
+	}
+	return crc;
+}
+
+/*
+ * Description :
+ * Feed one received byte to the frame parser.
+ * Returns TRUE when the byte completes a frame with a correct CRC.
+ */
+static boolean Protocol_processByte(uint8 data, Protocol_FrameType *frame_Ptr)
+{
+	switch (g_parserState)
+	{
+	case WAIT_START:
+		if (data == PROTOCOL_START_OF_FRAME)
+		{
+			g_parserState = WAIT_LENGTH;
+		}
+		break;
+
+	case WAIT_LENGTH:
+		if (data > PROTOCOL_MAX_PAYLOAD_SIZE)
+		{
+			/* Not a valid frame, look for the next start byte, which may be this one */
+			g_stats.length_errors++;
+			g_parserState = (data == PROTOCOL_START_OF_FRAME) ? WAIT_LENGTH : WAIT_START;
+			break;
+		}
+		g_parserFrame.length = data;
+		g_parserCrc = Protocol_crc8Update(0, data);
+		g_parserState = WAIT_TYPE;
+		break;
+
+	case WAIT_TYPE:
+		if (data < PROTOCOL_MSG_OPTION || data >= PROTOCOL_MSG_OPTION + PROTOCOL_MESSAGE_TYPES ||
+				g_parserFrame.length != g_payloadSize[data - PROTOCOL_MSG_OPTION])
+		{
+			/*
+			 * Unknown type or wrong length for the type, the handlers read fixed payload offsets
+			 * so a short frame would be handled with the payload left from the previous frame
+			 * The rejected byte may start the next frame
+			 */
+			g_stats.length_errors++;
+			g_parserState = (data == PROTOCOL_START_OF_FRAME) ? WAIT_LENGTH : WAIT_START;
+			break;
+		}
+		g_parserFrame.type = data;
+		g_parserCrc = Protocol_crc8Update(g_parserCrc, data);
+		g_parserIndex = 0;
+		g_parserState = (g_parserFrame.length == 0) ? WAIT_CRC : WAIT_PAYLOAD;
+		break;
+
+	case WAIT_PAYLOAD:
+		g_parserFrame.payload[g_parserIndex] = data;
+		g_parserCrc = Protocol_crc8Update(g_parserCrc, data);
+		g_parserIndex++;
+		if (g_parserIndex == g_parserFrame.length)
+		{
+			g_parserState = WAIT_CRC;
+		}
+		break;
+
+	case WAIT_CRC:
+		g_parserState = WAIT_START;
+		if (data != g_parserCrc)
+		{
+			/* A truncated frame may be followed by a start byte in place of its CRC */
+			g_stats.crc_errors++;
+			if (data == PROTOCOL_START_OF_FRAME)
+			{
+				g_parserState = WAIT_LENGTH;
+			}
+			break;
+		}
+		*frame_Ptr = g_parserFrame;
+		g_stats.frames_received++;
+		return TRUE;
+	}
+	return FALSE;
+}
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *
+ * Module Name: PROTOCOL
+ *
+ * File Name: protocol.h
+ *
+ * Description: Header file for the HMI ECU <-> CONTROL ECU Message Protocol
+ *
+ * Created on: Nov 12, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                  *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Frame format on the UART link:
+ * | SOF | LENGTH | TYPE | PAYLOAD (LENGTH bytes) | CRC-8 |
+ * The CRC-8 (polynomial 0x07) covers LENGTH, TYPE and PAYLOAD.
+ */
+#define PROTOCOL_START_OF_FRAME     0X7E
+#define PROTOCOL_MAX_PAYLOAD_SIZE   12
+#define PROTOCOL_CRC8_POLYNOMIAL    0X07
+
+/* Frame bytes other than the payload: SOF, LENGTH, TYPE and CRC */
+#define PROTOCOL_FRAME_OVERHEAD     4
+
+/* Payload size of every message type, frames of another length are dropped by the parser */
+#define PROTOCOL_OPTION_PAYLOAD_SIZE        1
+#define PROTOCOL_PASSWORD_PAYLOAD_SIZE      5
+#define PROTOCOL_NEW_PASSWORD_PAYLOAD_SIZE  10
+#define PROTOCOL_VERIFY_RESULT_PAYLOAD_SIZE 1
+#define PROTOCOL_DOOR_STATE_PAYLOAD_SIZE    3
+
+/*******************************************************************************
+ *                                Types Declarations                          *
+ *******************************************************************************/
+
+/* Enumeration Constants for Message Types */
+typedef enum {
+	PROTOCOL_MSG_OPTION = 1,    /* HMI -> CONTROL: [option] */
+	PROTOCOL_MSG_PASSWORD,      /* HMI -> CONTROL: [5 password digits] */
+	PROTOCOL_MSG_NEW_PASSWORD,  /* HMI -> CONTROL: [5 password digits][5 confirmation digits] */
+	PROTOCOL_MSG_VERIFY_RESULT, /* CONTROL -> HMI: [TRUE/FALSE] */
+	PROTOCOL_MSG_DOOR_STATE     /* CONTROL -> HMI: [door state][travel time of the last move in ms (2)] */
+} Protocol_MessageType;
+
+/* Enumeration Constants for the door states sent by the Control ECU as the door moves */
+typedef enum {
+	PROTOCOL_DOOR_UNLOCKING, /* Open move started */
+	PROTOCOL_DOOR_OPEN,      /* Open move ended, the door is held open */
+	PROTOCOL_DOOR_LOCKING,   /* Lock move started */
+	PROTOCOL_DOOR_LOCKED     /* Lock move ended */
+} Protocol_DoorState;
+
+/* Structure to hold a received frame */
+typedef struct {
+ Protocol_MessageType type;
+ uint8 length;
+ uint8 payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+} Protocol_FrameType;
+
+/* Structure to hold the link statistics */
+typedef struct {
+ uint16 frames_sent;
+ uint16 frames_received;
+ uint16 crc_errors;
+ uint16 length_errors;
+} Protocol_StatsType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Build a frame around the given payload and send it through UART.
+ * Payloads longer than PROTOCOL_MAX_PAYLOAD_SIZE are not sent.
+ */
+void Protocol_sendFrame(Protocol_MessageType type, const uint8 *payload_Ptr, uint8 length);
+
+/*
+ * Description :
+ * Wait until a complete frame with a correct CRC is received.
+ * Only frames of a known type and of its payload size are returned.
+ */
+void Protocol_receiveFrame(Protocol_FrameType *frame_Ptr);
+
+/*
+ * Description :
+ * Parse the bytes already received by UART without waiting.
+ * Returns TRUE when a complete frame with a correct CRC is stored in frame_Ptr.
+ * Only frames of a known type and of its payload size are returned.
+ */
+boolean Protocol_tryReceiveFrame(Protocol_FrameType *frame_Ptr);
+
+/*
+ * Description :
+ * Copy the link statistics counters.
+ */
+void Protocol_getStats(Protocol_StatsType *stats_Ptr);
+
+#endif /* PROTOCOL_H_ */
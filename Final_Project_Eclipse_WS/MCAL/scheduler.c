@@ -0,0 +1,270 @@
+/***************************************************************************
+ *
+ * Module Name: Scheduler
+ *
+ * File Name: scheduler.c
+ *
+ * Description: Source file for the Cooperative Run-To-Completion Event Scheduler
+ *
+ * Created on: Nov 16, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "scheduler.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#ifdef SCHEDULER_POWER_STATS
+#include "soft_timer.h"
+#endif
+#ifdef SCHEDULER_EVENT_CYCLES
+#include <util/delay.h>
+#endif
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+#define SCHEDULER_QUEUE_MASK (SCHEDULER_QUEUE_SIZE - 1)
+
+/*******************************************************************************
+ * 								 Global Variables
+ *******************************************************************************/
+
+/* Event queue, written by ISRs and the application, read by the event loop */
+static Scheduler_EventType g_queue[SCHEDULER_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+static volatile uint16 g_droppedCount = 0;
+
+#ifdef SCHEDULER_POWER_STATS
+
+static Scheduler_PowerStatsType g_powerStats[SCHEDULER_POWER_STATES];
+
+/* State the time is counted for, and the time counted up to */
+static uint8 g_powerState = 0;
+static uint32 g_powerTimeUs = 0;
+
+#endif
+
+#ifdef SCHEDULER_EVENT_CYCLES
+
+/* Cycles of one event of every source, waited for when the event is taken */
+static const uint16 g_eventCycles[] = {SCHEDULER_EVENT_CYCLES};
+
+#endif
+
+/*******************************************************************************
+ * 								 Functions Prototypes(Private)
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to take the oldest event from the queue
+ * Returns FALSE if the queue is empty
+ */
+static boolean Scheduler_getEvent(Scheduler_EventType * event_Ptr);
+
+/*
+ * Description:
+ * Function to sleep until the next interrupt if the queue is empty
+ */
+static void Scheduler_idle(void);
+
+#ifdef SCHEDULER_POWER_STATS
+
+/*
+ * Description:
+ * Function to count the time since the last call for the current state, as active or idle time
+ */
+static void Scheduler_countPower(boolean idle);
+
+#endif
+
+/*******************************************************************************
+ * 								 Functions Definitions
+ *******************************************************************************/
+void Scheduler_init(void){
+	g_queueHead = 0;
+	g_queueTail = 0;
+	g_droppedCount = 0;
+
+	/*
+	 * IDLE is the only sleep mode that keeps Timer1 and the UART running
+	 * Power-save only keeps the asynchronous Timer2, which is not used as the tick source
+	 */
+	set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+boolean Scheduler_postEvent(Scheduler_EventId id, uint8 param){
+	uint8 sreg;
+	uint8 next_tail;
+
+	/* The queue can be written from the application and from ISRs */
+	sreg = SREG;
+	cli();
+
+	next_tail = (g_queueTail + 1) & SCHEDULER_QUEUE_MASK;
+	if (next_tail == g_queueHead){
+		g_droppedCount++;
+		SREG = sreg;
+		return FALSE;
+	}
+
+	g_queue[g_queueTail].id = id;
+	g_queue[g_queueTail].param = param;
+	g_queueTail = next_tail;
+
+	SREG = sreg;
+	return TRUE;
+}
+
+void Scheduler_run(void (*a_handler)(const Scheduler_EventType * event_Ptr)){
+	Scheduler_EventType event;
+
+	while (1){
+		if (Scheduler_getEvent(&event)){
+#ifdef SCHEDULER_POWER_STATS
+			if (g_powerState < SCHEDULER_POWER_STATES){
+				g_powerStats[g_powerState].events++;
+			}
+#endif
+#ifdef SCHEDULER_EVENT_CYCLES
+			/* Before the handler, which may change the state the time is counted for */
+			_delay_us(g_eventCycles[event.id] / (F_CPU / 1000000UL));
+#endif
+			(*a_handler)(&event);
+		}
+		else{
+			Scheduler_idle();
+		}
+	}
+}
+
+uint16 Scheduler_getDroppedCount(void){
+	uint8 sreg;
+	uint16 count;
+
+	sreg = SREG;
+	cli();
+	count = g_droppedCount;
+	SREG = sreg;
+
+	return count;
+}
+
+static boolean Scheduler_getEvent(Scheduler_EventType * event_Ptr){
+	uint8 sreg;
+
+	sreg = SREG;
+	cli();
+
+	if (g_queueHead == g_queueTail){
+		SREG = sreg;
+		return FALSE;
+	}
+
+	*event_Ptr = g_queue[g_queueHead];
+	g_queueHead = (g_queueHead + 1) & SCHEDULER_QUEUE_MASK;
+
+	SREG = sreg;
+	return TRUE;
+}
+
+static void Scheduler_idle(void){
+	/*
+	 * The queue is checked with interrupts disabled, so an event posted after the check
+	 * wakes the CPU up: the instruction after SEI always runs before any pending interrupt
+	 */
+	cli();
+	if (g_queueHead == g_queueTail){
+#ifdef SCHEDULER_POWER_STATS
+		Scheduler_countPower(FALSE);
+#endif
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+#ifdef SCHEDULER_POWER_STATS
+		/* The ISR that woke the CPU up has already run, it is counted as idle time */
+		Scheduler_countPower(TRUE);
+#endif
+	}
+	sei();
+}
+
+#ifdef SCHEDULER_POWER_STATS
+
+void Scheduler_setPowerState(uint8 state){
+	if (state == g_powerState){
+		return;
+	}
+
+	/* The state changes while the CPU runs the event handler */
+	Scheduler_countPower(FALSE);
+	g_powerState = state;
+}
+
+void Scheduler_getPowerStats(uint8 state, Scheduler_PowerStatsType * stats_Ptr){
+	if (state >= SCHEDULER_POWER_STATES){
+		stats_Ptr -> active_us = 0;
+		stats_Ptr -> idle_us = 0;
+		stats_Ptr -> events = 0;
+		return;
+	}
+
+	*stats_Ptr = g_powerStats[state];
+}
+
+uint16 Scheduler_estimateCurrent(uint8 state){
+	Scheduler_PowerStatsType stats;
+	uint32 time_us;
+
+	Scheduler_getPowerStats(state, &stats);
+	time_us = stats.active_us + stats.idle_us;
+	if (time_us == 0){
+		return 0;
+	}
+
+	/* Weighted average of the active and idle currents, scaled down to avoid 32-bit overflow */
+	while (time_us > 0XFFFFUL){
+		stats.active_us >>= 1;
+		stats.idle_us >>= 1;
+		time_us = stats.active_us + stats.idle_us;
+	}
+	return (uint16)((stats.active_us * SCHEDULER_ACTIVE_CURRENT_UA + stats.idle_us * SCHEDULER_IDLE_CURRENT_UA) / time_us);
+}
+
+void Scheduler_reportPowerStats(void (*a_report)(uint8 state, const Scheduler_PowerStatsType * stats_Ptr, uint16 current)){
+	uint8 state;
+	Scheduler_PowerStatsType stats;
+
+	for (state = 0; state < SCHEDULER_POWER_STATES; state++){
+		Scheduler_getPowerStats(state, &stats);
+		if (stats.active_us == 0 && stats.idle_us == 0){
+			continue;
+		}
+		(*a_report)(state, &stats, Scheduler_estimateCurrent(state));
+	}
+}
+
+static void Scheduler_countPower(boolean idle){
+	uint32 time_us = SoftTimer_getTimeUs();
+
+	if (g_powerState < SCHEDULER_POWER_STATES){
+		if (idle){
+			g_powerStats[g_powerState].idle_us += time_us - g_powerTimeUs;
+		}
+		else{
+			g_powerStats[g_powerState].active_us += time_us - g_powerTimeUs;
+		}
+	}
+	g_powerTimeUs = time_us;
+}
+
+#endif
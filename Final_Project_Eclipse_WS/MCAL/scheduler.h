@@ -0,0 +1,150 @@
+/***************************************************************************
+ *
+ * Module Name: Scheduler
+ *
+ * File Name: scheduler.h
+ *
+ * Description: Header file for the Cooperative Run-To-Completion Event Scheduler
+ *
+ * Created on: Nov 16, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+
+/* Number of events that can wait in the queue, should be a power of two up to 256 */
+#define SCHEDULER_QUEUE_SIZE 16
+
+#if((SCHEDULER_QUEUE_SIZE & (SCHEDULER_QUEUE_SIZE - 1)) != 0) || (SCHEDULER_QUEUE_SIZE > 256)
+
+#error "Scheduler queue size should be a power of two not greater than 256"
+
+#endif
+
+/*
+ * Define SCHEDULER_POWER_STATS to measure in which application state the CPU is awake or sleeping
+ * and estimate the current drawn in each state. The time is read from the software timers
+ * (Timer1 counter) when the CPU goes to sleep, when it wakes up and when the state changes
+ * The power build of the host port defines it and prints the table, see make power in HOST_PORT
+ */
+#ifdef SCHEDULER_POWER_STATS
+
+/* Number of application states that can be measured */
+#define SCHEDULER_POWER_STATES 16
+
+/* Typical ATmega16 supply current at 8 MHz and 5V from the datasheet, MCU only */
+#define SCHEDULER_ACTIVE_CURRENT_UA 12000UL
+#define SCHEDULER_IDLE_CURRENT_UA    5500UL
+
+/*
+ * The host simulator defines SCHEDULER_EVENT_CYCLES as the cycles of one event of every source,
+ * in the order of Scheduler_EventId, and the scheduler waits for them before handling every event
+ * Its virtual clock stands still while code runs, so the awake time would be lost without them
+ */
+
+#endif
+
+/*******************************************************************************
+ * 								 User-Defined Data Types
+ *******************************************************************************/
+
+/* Enumeration Constants to define the event sources */
+typedef enum {
+	SCHEDULER_EVENT_UART_RX,  /* New bytes in the UART RX buffer */
+	SCHEDULER_EVENT_TIMER,    /* Software timer expired, param is the timer ID */
+	SCHEDULER_EVENT_KEYPAD,   /* Key events waiting in the keypad driver queue */
+	SCHEDULER_EVENT_MOTOR     /* DC motor move ended, param is the move result */
+} Scheduler_EventId;
+
+/* Structure Data Type to define one event */
+typedef struct {
+ Scheduler_EventId id;
+ uint8 param;
+} Scheduler_EventType;
+
+#ifdef SCHEDULER_POWER_STATS
+
+/* Structure Data Type to hold the measured time of one application state */
+typedef struct {
+ uint32 active_us;  /* CPU was running code */
+ uint32 idle_us;    /* CPU was sleeping */
+ uint32 events;     /* Events handled */
+} Scheduler_PowerStatsType;
+
+#endif
+
+/*******************************************************************************
+ * 								 Functions Prototypes
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to empty the event queue
+ */
+void Scheduler_init(void);
+
+/*
+ * Description:
+ * Function to add an event to the queue, it can be called from ISRs
+ * Returns FALSE and counts the event as dropped if the queue is full
+ */
+boolean Scheduler_postEvent(Scheduler_EventId id, uint8 param);
+
+/*
+ * Description:
+ * Function to run the event loop, it never returns
+ * Each event is passed to the given handler which must run to completion without waiting
+ * The CPU sleeps in IDLE mode while the queue is empty and wakes up on any interrupt
+ */
+void Scheduler_run(void (*a_handler)(const Scheduler_EventType * event_Ptr));
+
+/*
+ * Description:
+ * Function to return the number of events dropped because the queue was full
+ */
+uint16 Scheduler_getDroppedCount(void);
+
+#ifdef SCHEDULER_POWER_STATS
+
+/*
+ * Description:
+ * Function to set the application state the next time is counted for
+ * The event handler should call it when it changes the state, the time up to the call
+ * is counted for the previous state
+ */
+void Scheduler_setPowerState(uint8 state);
+
+/*
+ * Description:
+ * Function to copy the measured time of the given application state
+ */
+void Scheduler_getPowerStats(uint8 state, Scheduler_PowerStatsType * stats_Ptr);
+
+/*
+ * Description:
+ * Function to estimate the average current of the given application state in micro-amperes
+ * Returns 0 if the state has no measured time
+ */
+uint16 Scheduler_estimateCurrent(uint8 state);
+
+/*
+ * Description:
+ * Function to pass the measured time and the current estimate of every measured state to the given function
+ * The states without measured time are skipped
+ */
+void Scheduler_reportPowerStats(void (*a_report)(uint8 state, const Scheduler_PowerStatsType * stats_Ptr, uint16 current));
+
+#endif
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,279 @@
+/***************************************************************************
+ *
+ * Module Name: Soft Timer
+ *
+ * File Name: soft_timer.c
+ *
+ * Description: Source file for the Software Timers Service built on Timer1
+ *
+ * Created on: Nov 14, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "soft_timer.h"
+#include "timer1.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+#define SOFT_TIMER_WHEEL_MASK (SOFT_TIMER_WHEEL_SIZE - 1)
+
+/* Marks the end of a slot list */
+#define SOFT_TIMER_NONE 0XFF
+
+/* Timer1 compare value for one tick with F_CPU/64 pre-scaler */
+#define SOFT_TIMER_COMPARE_VALUE ((uint16)((F_CPU / 64UL / 1000UL) * SOFT_TIMER_TICK_MS - 1))
+
+/* Microseconds of one tick, and nanoseconds of one Timer1 count with F_CPU/64 pre-scaler */
+#define SOFT_TIMER_TICK_US  ((uint32)SOFT_TIMER_TICK_MS * 1000UL)
+#define SOFT_TIMER_COUNT_NS ((uint32)(64000000000ULL / F_CPU))
+
+/*******************************************************************************
+ * 								 User-Defined Data Types
+ *******************************************************************************/
+
+/* Structure Data Type to hold one software timer */
+typedef struct {
+	void (*callBack_Ptr)(uint8 timer_id);
+	uint16 period;   /* Ticks to reload for periodic timers */
+	uint16 rounds;   /* Full wheel turns left before expiry */
+	uint8 slot;      /* Wheel slot holding the timer */
+	uint8 next;      /* Next timer in the same slot */
+	uint8 prev;      /* Previous timer in the same slot */
+	SoftTimer_Mode mode;
+	boolean running;
+} SoftTimer_Type;
+
+/*******************************************************************************
+ * 								 Global Variables
+ *******************************************************************************/
+static SoftTimer_Type g_timers[SOFT_TIMER_MAX_TIMERS];
+
+/* Head of the timers list of each wheel slot */
+static uint8 g_wheel[SOFT_TIMER_WHEEL_SIZE];
+
+/* Slot processed by the last tick */
+static uint8 g_cursor = 0;
+
+/* Timers expired in the current tick whose call-back is not called yet */
+static volatile uint16 g_expiredMask = 0;
+
+static volatile uint32 g_ticks = 0;
+
+/*******************************************************************************
+ * 								 Functions Prototypes(Private)
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to add a timer to the wheel slot that expires after the given ticks
+ * Interrupts must be disabled by the caller
+ */
+static void SoftTimer_insert(uint8 timer_id, uint16 ticks);
+
+/*
+ * Description:
+ * Function to remove a timer from its wheel slot
+ * Interrupts must be disabled by the caller
+ */
+static void SoftTimer_unlink(uint8 timer_id);
+
+/*
+ * Description:
+ * Call-back function of Timer1, advances the wheel by one tick
+ */
+static void SoftTimer_processTick(void);
+
+/*******************************************************************************
+ * 								 Functions Definitions
+ *******************************************************************************/
+void SoftTimer_init(void){
+	uint8 i;
+
+	/* Configurations for Timer1 to generate an interrupt every tick */
+	Timer1_ConfigType Timer1_TickConfigs = {0, SOFT_TIMER_COMPARE_VALUE, F_CPU_64, COMPARE_MODE};
+
+	for (i = 0; i < SOFT_TIMER_WHEEL_SIZE; i++){
+		g_wheel[i] = SOFT_TIMER_NONE;
+	}
+	for (i = 0; i < SOFT_TIMER_MAX_TIMERS; i++){
+		g_timers[i].running = FALSE;
+	}
+	g_cursor = 0;
+	g_expiredMask = 0;
+	g_ticks = 0;
+
+	Timer1_setCallBack(SoftTimer_processTick);
+	Timer1_init(&Timer1_TickConfigs);
+}
+
+void SoftTimer_start(uint8 timer_id, uint16 ticks, SoftTimer_Mode mode, void(*a_ptr)(uint8 timer_id)){
+	uint8 sreg;
+
+	if (timer_id >= SOFT_TIMER_MAX_TIMERS){
+		return;
+	}
+
+	/* A timer can not expire in the tick it is started in */
+	if (ticks == 0){
+		ticks = 1;
+	}
+
+	/* The wheel is shared with the Timer1 ISR */
+	sreg = SREG;
+	cli();
+
+	if (g_timers[timer_id].running){
+		SoftTimer_unlink(timer_id);
+	}
+	g_expiredMask &= ~(1U << timer_id);
+
+	g_timers[timer_id].callBack_Ptr = a_ptr;
+	g_timers[timer_id].period = ticks;
+	g_timers[timer_id].mode = mode;
+	SoftTimer_insert(timer_id, ticks);
+
+	SREG = sreg;
+}
+
+void SoftTimer_stop(uint8 timer_id){
+	uint8 sreg;
+
+	if (timer_id >= SOFT_TIMER_MAX_TIMERS){
+		return;
+	}
+
+	sreg = SREG;
+	cli();
+
+	if (g_timers[timer_id].running){
+		SoftTimer_unlink(timer_id);
+	}
+	g_expiredMask &= ~(1U << timer_id);
+
+	SREG = sreg;
+}
+
+boolean SoftTimer_isRunning(uint8 timer_id){
+	if (timer_id >= SOFT_TIMER_MAX_TIMERS){
+		return FALSE;
+	}
+	return g_timers[timer_id].running;
+}
+
+uint32 SoftTimer_getTicks(void){
+	uint8 sreg;
+	uint32 ticks;
+
+	/* 32-bit read must not be split by the Timer1 ISR */
+	sreg = SREG;
+	cli();
+	ticks = g_ticks;
+	SREG = sreg;
+
+	return ticks;
+}
+
+uint32 SoftTimer_getTimeUs(void){
+	uint8 sreg;
+	uint32 ticks;
+	uint16 count;
+	boolean pending;
+
+	sreg = SREG;
+	cli();
+	ticks = g_ticks;
+	count = Timer1_getCount(&pending);
+
+	/* The counter restarted but the tick is not counted yet, read it again after the restart */
+	if (pending){
+		ticks++;
+		count = Timer1_getCount(&pending);
+	}
+	SREG = sreg;
+
+	return ticks * SOFT_TIMER_TICK_US + ((uint32)count * SOFT_TIMER_COUNT_NS) / 1000UL;
+}
+
+static void SoftTimer_insert(uint8 timer_id, uint16 ticks){
+	uint8 slot = (g_cursor + ticks) & SOFT_TIMER_WHEEL_MASK;
+	SoftTimer_Type * timer_Ptr = &g_timers[timer_id];
+
+	/* The slot is visited once every wheel turn, the first visit is after (ticks % size) ticks */
+	timer_Ptr -> rounds = (ticks - 1) / SOFT_TIMER_WHEEL_SIZE;
+	timer_Ptr -> slot = slot;
+
+	/* Insert at the head of the slot list */
+	timer_Ptr -> prev = SOFT_TIMER_NONE;
+	timer_Ptr -> next = g_wheel[slot];
+	if (g_wheel[slot] != SOFT_TIMER_NONE){
+		g_timers[g_wheel[slot]].prev = timer_id;
+	}
+	g_wheel[slot] = timer_id;
+
+	timer_Ptr -> running = TRUE;
+}
+
+static void SoftTimer_unlink(uint8 timer_id){
+	SoftTimer_Type * timer_Ptr = &g_timers[timer_id];
+
+	if (timer_Ptr -> prev != SOFT_TIMER_NONE){
+		g_timers[timer_Ptr -> prev].next = timer_Ptr -> next;
+	}
+	else{
+		g_wheel[timer_Ptr -> slot] = timer_Ptr -> next;
+	}
+	if (timer_Ptr -> next != SOFT_TIMER_NONE){
+		g_timers[timer_Ptr -> next].prev = timer_Ptr -> prev;
+	}
+
+	timer_Ptr -> running = FALSE;
+}
+
+static void SoftTimer_processTick(void){
+	uint8 timer_id;
+	uint8 next_id;
+
+	g_ticks++;
+	g_cursor = (g_cursor + 1) & SOFT_TIMER_WHEEL_MASK;
+
+	/* First pass: collect the expired timers of this slot */
+	timer_id = g_wheel[g_cursor];
+	while (timer_id != SOFT_TIMER_NONE){
+		next_id = g_timers[timer_id].next;
+
+		if (g_timers[timer_id].rounds == 0){
+			SoftTimer_unlink(timer_id);
+			g_expiredMask |= (1U << timer_id);
+		}
+		else{
+			g_timers[timer_id].rounds--;
+		}
+
+		timer_id = next_id;
+	}
+
+	/*
+	 * Second pass: reload periodic timers and call the call-back functions
+	 * A call-back function may stop or restart any timer, which clears its expired bit
+	 */
+	for (timer_id = 0; g_expiredMask != 0; timer_id++){
+		if (g_expiredMask & (1U << timer_id)){
+			g_expiredMask &= ~(1U << timer_id);
+
+			if (g_timers[timer_id].mode == SOFT_TIMER_PERIODIC){
+				SoftTimer_insert(timer_id, g_timers[timer_id].period);
+			}
+			if (g_timers[timer_id].callBack_Ptr != NULL_PTR){
+				g_timers[timer_id].callBack_Ptr(timer_id);
+			}
+		}
+	}
+}
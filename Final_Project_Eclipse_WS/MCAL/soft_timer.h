@@ -0,0 +1,102 @@
+/***************************************************************************
+ *
+ * Module Name: Soft Timer
+ *
+ * File Name: soft_timer.h
+ *
+ * Description: Header file for the Software Timers Service built on Timer1
+ *
+ * Created on: Nov 14, 2022
+ *
+ * Author: Omar EL-Sheikh
+ *
+ **************************************************************************/
+#ifndef SOFT_TIMER_H_
+#define SOFT_TIMER_H_
+
+/*******************************************************************************
+ * 								 Inclusions
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ * 								 Definitions
+ *******************************************************************************/
+
+/* Period of the Timer1 tick that drives all software timers */
+#define SOFT_TIMER_TICK_MS       10
+
+/* Number of software timers, timer IDs go from 0 to SOFT_TIMER_MAX_TIMERS - 1 */
+#define SOFT_TIMER_MAX_TIMERS    8
+
+/* Number of slots in the timer wheel, should be a power of two */
+#define SOFT_TIMER_WHEEL_SIZE    16
+
+#if(SOFT_TIMER_MAX_TIMERS > 16)
+
+#error "Number of software timers should not be greater than 16"
+
+#endif
+
+#if((SOFT_TIMER_WHEEL_SIZE & (SOFT_TIMER_WHEEL_SIZE - 1)) != 0)
+
+#error "Timer wheel size should be a power of two"
+
+#endif
+
+/* Convert a time in milliseconds to ticks, rounding up */
+#define SOFT_TIMER_MS_TO_TICKS(ms) ((uint16)(((ms) + SOFT_TIMER_TICK_MS - 1) / SOFT_TIMER_TICK_MS))
+
+/*******************************************************************************
+ * 								 User-Defined Data Types
+ *******************************************************************************/
+
+/* Enumeration Constants to define the software timer modes */
+typedef enum {
+	SOFT_TIMER_ONE_SHOT, SOFT_TIMER_PERIODIC
+} SoftTimer_Mode;
+
+/*******************************************************************************
+ * 								 Functions Prototypes
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Function to start Timer1 as the tick source of the software timers
+ */
+void SoftTimer_init(void);
+
+/*
+ * Description:
+ * Function to start (or restart) the given timer to expire after the given ticks
+ * The call-back function is called from the Timer1 ISR with the timer ID
+ * Periodic timers are restarted with the same ticks before calling the call-back function
+ */
+void SoftTimer_start(uint8 timer_id, uint16 ticks, SoftTimer_Mode mode, void(*a_ptr)(uint8 timer_id));
+
+/*
+ * Description:
+ * Function to stop the given timer, its call-back function will not be called
+ */
+void SoftTimer_stop(uint8 timer_id);
+
+/*
+ * Description:
+ * Function to check if the given timer is running
+ */
+boolean SoftTimer_isRunning(uint8 timer_id);
+
+/*
+ * Description:
+ * Function to return the number of ticks since SoftTimer_init
+ */
+uint32 SoftTimer_getTicks(void);
+
+/*
+ * Description:
+ * Function to return the time since SoftTimer_init in microseconds, from the ticks and the Timer1 counter
+ * The resolution is one Timer1 count (8us at 8MHz), the time wraps around after about 71 minutes
+ */
+uint32 SoftTimer_getTimeUs(void);
+
+#endif /* SOFT_TIMER_H_ */
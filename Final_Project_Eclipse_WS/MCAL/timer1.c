@@ -59,6 +59,20 @@ void Timer1_deInit(void){
 	TIMSK &= (0XEB); /* Disabling Interrupt Bits */
 }
 
+uint16 Timer1_getCount(boolean * pending_Ptr){
+	uint16 count = TCNT1;
+
+	/* Compare match flag in CTC mode, overflow flag in Normal mode */
+	if (BIT_IS_SET(TCCR1B, WGM12)){
+		*pending_Ptr = BIT_IS_SET(TIFR, OCF1A) ? TRUE : FALSE;
+	}
+	else{
+		*pending_Ptr = BIT_IS_SET(TIFR, TOV1) ? TRUE : FALSE;
+	}
+
+	return count;
+}
+
 ISR (TIMER1_COMPA_vect){
 	if(g_Timer1_Call_Back != NULL_PTR)
 	{
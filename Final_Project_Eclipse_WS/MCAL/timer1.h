@@ -69,5 +69,12 @@ void Timer1_setCallBack(void(*a_ptr)(void));
  */
 void Timer1_deInit(void);
 
+/*
+ * Description:
+ * Function to read the Timer1 counter, it should be called with interrupts disabled
+ * pending_Ptr is set to TRUE if the counter restarted and its interrupt is not served yet
+ */
+uint16 Timer1_getCount(boolean * pending_Ptr);
+
 
 #endif /* TIMER1_H_ */
@@ -0,0 +1,390 @@
+/***************************************************************************
+ *
+ * Module Name: UART
+ * 	 
+ * File Name: uart.c
+ *
+ * Description: Source file for ATmega16 UART Driver
+ *
+ * Created on: Oct 24, 2022
+ *
+ * Author: Omar EL-Sheikh
+ * 
+ **************************************************************************/
+
+#include "uart.h"
+#include "avr/io.h" /* To use the UART Registers */
+#include <avr/interrupt.h> /* To use the UART ISRs */
+#include "common_macros.h" /* To use the macros like SET_BIT */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define UART_RX_BUFFER_MASK (UART_RX_BUFFER_SIZE - 1)
+#define UART_TX_BUFFER_MASK (UART_TX_BUFFER_SIZE - 1)
+
+/*******************************************************************************
+ *                      Global Variables                                       *
+ *******************************************************************************/
+
+/* Selected driver mode, saved at initialization */
+static UART_Mode g_uartMode = UART_POLLING_MODE;
+
+/* RX ring buffer, head is written by the RXC ISR and tail by the application */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+/* TX ring buffer, head is written by the application and tail by the UDRE ISR */
+static volatile uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+static volatile uint8 g_txHead = 0;
+static volatile uint8 g_txTail = 0;
+
+/* Overrun counters */
+static volatile uint16 g_rxOverrunCount = 0;
+static volatile uint16 g_hwOverrunCount = 0;
+
+/* Call-back function called when a byte is received in interrupt mode */
+static void (*volatile g_UART_RxCallBack)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Functional responsible for Initialize the UART device by:
+ * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
+ * 2. Enable the UART.
+ * 3. Setup the UART baud rate.
+ * 4. Enable the RX Complete interrupt in case of interrupt mode.
+ */
+void UART_init(const UART_ConfigType * UART_Configs_Ptr)
+{
+	uint16 ubrr_value = 0;
+
+	/* Empty the ring buffers and save the driver mode */
+	g_uartMode = UART_Configs_Ptr -> mode;
+	g_rxHead = 0;
+	g_rxTail = 0;
+	g_txHead = 0;
+	g_txTail = 0;
+
+	/* U2X = 1 for double transmission speed */
+	UCSRA = (1<<U2X);
+
+	/************************** UCSRB Description **************************
+	 * RXCIE = 1 in interrupt mode to fill the RX buffer from the ISR
+	 * TXCIE = 0 Disable USART Tx Complete Interrupt Enable
+	 * UDRIE = 0 at start, it is enabled only while the TX buffer has data
+	 * RXEN  = 1 Receiver Enable
+	 * RXEN  = 1 Transmitter Enable
+	 * UCSZ2 = Bit-2 of bit data
+	 * RXB8 & TXB8 not used for 8-bit data mode
+	 ***********************************************************************/
+	UCSRB = (1 << RXEN) | (1 << TXEN);
+	UCSRB = (UCSRB & (0XFB)) | ((UART_Configs_Ptr -> bit_Data) & (0X04));
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		SET_BIT(UCSRB,RXCIE);
+	}
+
+	/************************** UCSRC Description **************************
+	 * URSEL   = 1 The URSEL must be one when writing the UCSRC
+	 * UMSEL   = 0 Asynchronous Operation
+	 * UPM1:0  = Parity bits of configurations
+	 * USBS    = Stop bit of configurations
+	 * UCSZ1:0 = data bits of configurations
+	 * UCPOL   = 0 Used with the Synchronous operation only
+	 ***********************************************************************/
+	UCSRC = (1 << URSEL);
+	UCSRC = (UCSRC & (0XFC)) | (((UART_Configs_Ptr -> bit_Data) & (0XFB)) << 1);
+	UCSRC = (UCSRC & (0XF7)) | ((UART_Configs_Ptr -> stop_Bit) << 3);
+	UCSRC = (UCSRC & (0XCF)) | ((UART_Configs_Ptr -> parity) << 4);
+	/* Calculate the UBRR register value */
+	ubrr_value = (uint16)(((F_CPU / ((UART_Configs_Ptr -> baud_Rate) * 8UL))) - 1);
+
+	/* First 8 bits from the BAUD_PRESCALE inside UBRRL and last 4 bits in UBRRH*/
+	UBRRH = ubrr_value >> 8;
+	UBRRL = ubrr_value;
+}
+
+/*
+ * Description :
+ * Functional responsible for send byte to another UART device.
+ * In interrupt mode the byte is queued and the function only waits if the TX buffer is full.
+ */
+void UART_sendByte(const uint8 data)
+{
+	uint8 next_head;
+
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		next_head = (g_txHead + 1) & UART_TX_BUFFER_MASK;
+
+		/* Wait until the UDRE ISR frees a place in the TX buffer */
+		while(next_head == g_txTail){}
+
+		g_txBuffer[g_txHead] = data;
+		g_txHead = next_head;
+
+		/* Let the UDRE ISR move the queued bytes to UDR */
+		SET_BIT(UCSRB,UDRIE);
+		return;
+	}
+
+	/*
+	 * UDRE flag is set when the Tx buffer (UDR) is empty and ready for
+	 * transmitting a new byte so wait until this flag is set to one
+	 */
+	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+
+	/*
+	 * Put the required data in the UDR register and it also clear the UDRE flag as
+	 * the UDR register is not empty now
+	 */
+	UDR = data;
+
+	/************************* Another Method *************************
+	UDR = data;
+	while(BIT_IS_CLEAR(UCSRA,TXC)){} // Wait until the transmission is complete TXC = 1
+	SET_BIT(UCSRA,TXC); // Clear the TXC flag
+	*******************************************************************/
+}
+
+/*
+ * Description :
+ * Functional responsible for receive byte from another UART device.
+ * In interrupt mode the byte is taken from the RX buffer once available.
+ */
+uint8 UART_recieveByte(void)
+{
+	uint8 data;
+
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		/* Wait until the RXC ISR puts a byte in the RX buffer */
+		while(!UART_tryReceive(&data)){}
+		return data;
+	}
+
+	/* RXC flag is set when the UART receive data so wait until this flag is set to one */
+	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+
+	/* Count the lost bytes before reading UDR, as reading it clears the DOR flag */
+	if (BIT_IS_SET(UCSRA,DOR))
+	{
+		g_hwOverrunCount++;
+	}
+
+	/*
+	 * Read the received data from the Rx buffer (UDR)
+	 * The RXC flag will be cleared after read the data
+	 */
+    return UDR;
+}
+
+/*
+ * Description :
+ * Take a received byte if there is one without waiting.
+ * Returns TRUE and stores the byte in data_Ptr if a byte was available, FALSE otherwise.
+ */
+boolean UART_tryReceive(uint8 *data_Ptr)
+{
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		if (g_rxHead == g_rxTail)
+		{
+			return FALSE;
+		}
+		*data_Ptr = g_rxBuffer[g_rxTail];
+		g_rxTail = (g_rxTail + 1) & UART_RX_BUFFER_MASK;
+		return TRUE;
+	}
+
+	if (BIT_IS_CLEAR(UCSRA,RXC))
+	{
+		return FALSE;
+	}
+	*data_Ptr = UART_recieveByte();
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Queue up to size bytes for transmission without waiting.
+ * Returns the number of bytes accepted, the caller should retry the rest later.
+ */
+uint8 UART_write(const uint8 *data_Ptr, uint8 size)
+{
+	uint8 count = 0;
+	uint8 next_head;
+
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		while (count < size)
+		{
+			next_head = (g_txHead + 1) & UART_TX_BUFFER_MASK;
+			if (next_head == g_txTail)
+			{
+				break; /* TX buffer is full */
+			}
+			g_txBuffer[g_txHead] = data_Ptr[count];
+			g_txHead = next_head;
+			count++;
+		}
+
+		if (count != 0)
+		{
+			SET_BIT(UCSRB,UDRIE);
+		}
+		return count;
+	}
+
+	/* In polling mode only write while UDR is free */
+	while ((count < size) && BIT_IS_SET(UCSRA,UDRE))
+	{
+		UDR = data_Ptr[count];
+		count++;
+	}
+	return count;
+}
+
+/*
+ * Description :
+ * Return the number of received bytes dropped because the RX buffer was full.
+ */
+uint16 UART_getRxOverrunCount(void)
+{
+	uint16 count;
+
+	/* 16-bit read must not be split by the RXC ISR */
+	CLEAR_BIT(UCSRB,RXCIE);
+	count = g_rxOverrunCount;
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		SET_BIT(UCSRB,RXCIE);
+	}
+	return count;
+}
+
+/*
+ * Description :
+ * Return the number of Data OverRun errors (DOR) reported by the UART hardware.
+ */
+uint16 UART_getHwOverrunCount(void)
+{
+	uint16 count;
+
+	CLEAR_BIT(UCSRB,RXCIE);
+	count = g_hwOverrunCount;
+	if (g_uartMode == UART_INTERRUPT_MODE)
+	{
+		SET_BIT(UCSRB,RXCIE);
+	}
+	return count;
+}
+
+/*
+ * Description :
+ * Set the call-back function called from the RXC ISR after a byte is put in the RX buffer.
+ * Only used in interrupt mode.
+ */
+void UART_setRxCallBack(void(*a_ptr)(void))
+{
+	/* Saving the address of the call back function in a global pointer to function */
+	g_UART_RxCallBack = a_ptr;
+}
+
+/*
+ * Description :
+ * Send the required string through UART to the other UART device.
+ */
+void UART_sendString(const uint8 *Str)
+{
+	uint8 i = 0;
+
+	/* Send the whole string */
+	while(Str[i] != '\0')
+	{
+		UART_sendByte(Str[i]);
+		i++;
+	}
+	/************************* Another Method *************************
+	while(*Str != '\0')
+	{
+		UART_sendByte(*Str);
+		Str++;
+	}
+	*******************************************************************/
+}
+
+/*
+ * Description :
+ * Receive the required string until the '#' symbol through UART from the other UART device.
+ */
+void UART_receiveString(uint8 *Str)
+{
+	uint8 i = 0;
+
+	/* Receive the first byte */
+	Str[i] = UART_recieveByte();
+
+	/* Receive the whole string until the '#' */
+	while(Str[i] != '#')
+	{
+		i++;
+		Str[i] = UART_recieveByte();
+	}
+
+	/* After receiving the whole string plus the '#', replace the '#' with '\0' */
+	Str[i] = '\0';
+}
+
+/*******************************************************************************
+ *                      Interrupt Service Routines                             *
+ *******************************************************************************/
+
+ISR(USART_RXC_vect)
+{
+	uint8 status = UCSRA;
+	uint8 data = UDR; /* Reading UDR clears the RXC flag */
+	uint8 next_head = (g_rxHead + 1) & UART_RX_BUFFER_MASK;
+
+	if (status & (1 << DOR))
+	{
+		g_hwOverrunCount++;
+	}
+
+	if (next_head == g_rxTail)
+	{
+		/* RX buffer is full, the byte is dropped */
+		g_rxOverrunCount++;
+	}
+	else
+	{
+		g_rxBuffer[g_rxHead] = data;
+		g_rxHead = next_head;
+
+		if (g_UART_RxCallBack != NULL_PTR)
+		{
+			/* Notify the application that a byte is waiting in the RX buffer */
+			(*g_UART_RxCallBack)();
+		}
+	}
+}
+
+ISR(USART_UDRE_vect)
+{
+	if (g_txTail == g_txHead)
+	{
+		/* Nothing left to send, disable the interrupt until the next byte is queued */
+		CLEAR_BIT(UCSRB,UDRIE);
+	}
+	else
+	{
+		UDR = g_txBuffer[g_txTail];
+		g_txTail = (g_txTail + 1) & UART_TX_BUFFER_MASK;
+	}
+}
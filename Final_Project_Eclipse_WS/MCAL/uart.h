@@ -18,6 +18,27 @@
  *                                Inclusions                                  *
  *******************************************************************************/
 #include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Ring buffers sizes used in the interrupt mode, each should be a power of two up to 256 */
+#define UART_RX_BUFFER_SIZE 32
+#define UART_TX_BUFFER_SIZE 32
+
+#if((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) != 0) || (UART_RX_BUFFER_SIZE > 256)
+
+#error "UART RX buffer size should be a power of two not greater than 256"
+
+#endif
+
+#if((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) != 0) || (UART_TX_BUFFER_SIZE > 256)
+
+#error "UART TX buffer size should be a power of two not greater than 256"
+
+#endif
+
 /*******************************************************************************
  *                                Types Declarations                          *
  *******************************************************************************/
@@ -45,12 +66,18 @@ typedef enum {
 	BAUD_RATE_128000 = 128000, BAUD_RATE_256000 = 256000
 } UART_BaudRate;
 
+/* Enumeration Constants for Driver Mode */
+typedef enum {
+	UART_POLLING_MODE, UART_INTERRUPT_MODE
+} UART_Mode;
+
 /* Structure to define UART Configurations */
 typedef struct{
  UART_BitData bit_Data;
  UART_Parity parity;
  UART_StopBit stop_Bit;
  UART_BaudRate baud_Rate;
+ UART_Mode mode;
 } UART_ConfigType;
 
 /*******************************************************************************
@@ -63,21 +90,57 @@ typedef struct{
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
  * 2. Enable the UART.
  * 3. Setup the UART baud rate.
+ * 4. Enable the RX Complete interrupt in case of interrupt mode.
  */
 void UART_init(const UART_ConfigType * UART_Configs_Ptr);
 
 /*
  * Description :
  * Functional responsible for send byte to another UART device.
+ * In interrupt mode the byte is queued and the function only waits if the TX buffer is full.
  */
 void UART_sendByte(const uint8 data);
 
 /*
  * Description :
  * Functional responsible for receive byte from another UART device.
+ * In interrupt mode the byte is taken from the RX buffer once available.
  */
 uint8 UART_recieveByte(void);
 
+/*
+ * Description :
+ * Take a received byte if there is one without waiting.
+ * Returns TRUE and stores the byte in data_Ptr if a byte was available, FALSE otherwise.
+ */
+boolean UART_tryReceive(uint8 *data_Ptr);
+
+/*
+ * Description :
+ * Queue up to size bytes for transmission without waiting.
+ * Returns the number of bytes accepted, the caller should retry the rest later.
+ */
+uint8 UART_write(const uint8 *data_Ptr, uint8 size);
+
+/*
+ * Description :
+ * Return the number of received bytes dropped because the RX buffer was full.
+ */
+uint16 UART_getRxOverrunCount(void);
+
+/*
+ * Description :
+ * Return the number of Data OverRun errors (DOR) reported by the UART hardware.
+ */
+uint16 UART_getHwOverrunCount(void);
+
+/*
+ * Description :
+ * Set the call-back function called from the RXC ISR after a byte is put in the RX buffer.
+ * Only used in interrupt mode.
+ */
+void UART_setRxCallBack(void(*a_ptr)(void));
+
 /*
  * Description :
  * Send the required string through UART to the other UART device.